@@ -0,0 +1,182 @@
+/*!
+ * \file ClockServo.h
+ * \brief Timer discipline: PPS phase => ARR for the next second.
+ *
+ * Model (timer ticks): x(k+1) = x(k) + F - u(k), x phase of PPS in the timer (pps),
+ * F ticks of timer in one second (less 1, ARR counts from 0), u ARR of second k.
+ * State is phase and frequency; two estimators:
+ * - PI: u = F' + Kp x, F' += Ki x, with Kp = 2 zeta / tau, Ki = 1 / tau^2 (tau in s,
+ *   zeta = 1 gives double pole at 1 - 1/tau, no overshoot)
+ * - Kalman: 2 states [x, F], q_x white phase (timer), q_f random walk of frequency,
+ *   r PPS noise (all in ticks^2); u = F + x / tau
+ *
+ * Holdover (no PPS): F from the average of the last minutes and the learned aging
+ * (change of F in ticks/s per s), the phase error is only estimated (error()).
+ * When PPS is back the phase is steered out by the loop, timer is not set.
+ *
+ * Output: phase steering is limited to slew ticks/s (big difference is spread over
+ * seconds), fractional ARR is dithered between N and N+1 by first order sigma-delta.
+ * While the steering is at the limit the frequency is not changed (the phase would be
+ * taken as frequency: Kalman gain, PI integral), so ARR stays within F +- slew; not
+ * before the frequency is known (start), a frequency error can be larger than slew.
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INC_CLOCKSERVO_H_
+#define INC_CLOCKSERVO_H_
+
+#include <algorithm>
+#include <cmath>
+
+class ClockServo
+    {
+public:
+    enum Mode
+        {
+        PI, KALMAN
+        };
+
+    /*!
+     * \param f0 nominal ARR (timer frequency - 1)
+     * \param m estimator
+     */
+    ClockServo(double f0, Mode m = KALMAN);
+
+    void setPI(double tau, double zeta = 1.0);
+    void setKalman(double q_x, double q_f, double r, double tau);
+
+    /*!
+     * \brief noises measured (Allan deviation), loop time constant follows; white phase
+     * of the timer (rounding, 1/12 tick^2) is in r. Kalman: the matched filter sets
+     * the time constant, its phase is steered out in 1 s
+     *
+     * \param r PPS white phase noise [ticks^2]
+     * \param q_f frequency random walk [ticks^2/s^3]
+     */
+    void tune(double r, double q_f);
+
+    // max phase steering [ticks/s]
+    void setSlew(double s)
+        {
+        slew = s;
+        }
+
+    // fractional ARR by sigma-delta (default) or only rounded
+    void setDither(bool on)
+        {
+        dither = on;
+        sd = 0;
+        }
+
+    // time constant of the loop [s], 2 state Kalman: (r / q_f)^(1/4)
+    double loop_tau() const
+        {
+        return std::sqrt(std::sqrt(r / qf));
+        }
+
+    /*!
+     * \brief one PPS measurement
+     *
+     * \param x phase: timer count at PPS less the wanted one (pps)
+     * \return ARR for the coming second
+     */
+    int update(int x);
+
+    // no measurement (bad fix, no PPS): run on the frequency, phase goes on by model
+    int hold();
+
+    // timer was set at PPS (phase jump to 0): phase is known, frequency is kept
+    void restart();
+
+    double freq() const
+        {
+        return f;
+        }
+
+    double phase() const
+        {
+        return x;
+        }
+
+    // learned aging [ticks/s^2]
+    double drift() const
+        {
+        return aging;
+        }
+
+    // estimated time error (1 sigma, ticks), grows in holdover, also by the error of
+    // the learned aging (t^2 / 2)
+    double error() const
+        {
+        double t2 = 0.5 * nhold * nhold;
+        return std::sqrt(p00 + aging_var / (2 * AGING_AVG - 1) * t2 * t2);
+        }
+
+    // seconds in holdover, 0 locked
+    int held() const
+        {
+        return nhold;
+        }
+
+private:
+    int output();
+    void learn();
+
+    // phase steering added to the frequency, limited
+    double steer(double s) const
+        {
+        return std::clamp(s, -slew, slew);
+        }
+
+    // steering at the limit: frequency is kept
+    bool saturated(double s) const
+        {
+        return f_known && std::fabs(s) > slew;
+        }
+
+    // default slew ~22 ppm
+    static constexpr double SLEW_MAX {2000};
+
+    // frequency average time constant [s], aging measured in windows [s], averaged over
+    static const int F_AVG_T {600};
+    static const int AGING_WIN {3600};
+    static const int AGING_AVG {8};
+
+    Mode mode;
+
+    // estimated phase and frequency
+    double x {0};
+    double f;
+    // ARR of the last second, sigma-delta residual
+    double u;
+    double sd {0};
+    bool dither {true};
+    double slew {SLEW_MAX};
+
+    // long time frequency, aging and its window
+    double f_avg;
+    double aging {0};
+    // variance of one window's aging around the learned one
+    double aging_var {0};
+    double f_mark;
+    int win {-F_AVG_T};
+    int nhold {0};
+    // f_avg was measured locked once (after start)
+    bool f_known {false};
+
+    // PI
+    double kp {0};
+    double ki {0};
+
+    // Kalman: covariance, noises, phase time constant
+    double p00 {0};
+    double p01 {0};
+    double p11 {0};
+    double qx {0};
+    double qf {0};
+    double r {0};
+    double tau {0};
+    };
+
+#endif /* INC_CLOCKSERVO_H_ */
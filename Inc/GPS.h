@@ -19,6 +19,10 @@
 #include <cstring>
 #include "main.h"
 #include "GPSsat.h"
+#include "NmeaCheck.h"
+#include "NmeaFields.h"
+#include "NmeaStream.h"
+#include "NmeaTag.h"
 
 class GPS
     {
@@ -27,9 +31,33 @@ private:
     const static uint8_t RCM_FLT {0b010};
     const static uint8_t RCM_FLD {0b100};
     const static uint8_t RCM_FLTD {RCM_FLT | RCM_FLT};
+    const static uint8_t GGA_FL {0b1000};
+    const static uint8_t GSA_FL {0b10000};
 
     //static std::vector<std::string> mainBuf;
 
+    // handler of one sentence type, sys from talker ID
+    typedef bool (*Handler)(const NmeaFields &fields, gnss::Sys sys);
+    static const Handler handlers[nmea::TYPE_NB];
+
+    static bool parse_rmc(const NmeaFields &fields, gnss::Sys sys);
+    static bool parse_gsv(const NmeaFields &fields, gnss::Sys sys);
+    static bool parse_gga(const NmeaFields &fields, gnss::Sys sys);
+    static bool parse_gsa(const NmeaFields &fields, gnss::Sys sys);
+
+    // GSV messages of one system
+    struct GsvBurst
+        {
+        int tot {0};
+        int cur {0};
+        int inView {0};
+        bool done {false};
+        };
+    static GsvBurst gsv[gnss::SYS_NB];
+    // GSA of the system is read
+    static bool gsa_done[gnss::SYS_NB];
+    static void check_gsv_done();
+
 public:
 // GPS buffer
     const static int RXSZ {403};
@@ -46,11 +74,7 @@ public:
     static uint8_t gps_rxTmp[RXSZ];
 
 // parser
-// accepted sentences
-    static const std::string GSV;
-    static const std::string RMC;
-    static const int RMC_ID {1};
-    static const int GSV_ID {2};
+// accepted sentences, see nmea::TAGS, sentenceID is nmea::Type of the last one
     static int sentenceID;
 
     static int gps_second;
@@ -62,6 +86,47 @@ public:
 
     static int gps_sattNumb;
 
+// fix quality (RMC status, GGA, GSA), DOP are * 100, -1 not known
+    static bool rmc_valid;
+    static int fix_quality;   // GGA: 0 no fix, 1 GPS, 2 DGPS, ...
+    static int sats_used;
+    static int fix_mode;      // GSA: 1 no fix, 2 2D, 3 3D
+    static int hdop;
+    static int pdop;
+    static int vdop;
+    // satellites in the solution, bit (prn - 1) per system
+    static uint64_t used[gnss::SYS_NB];
+
+    // worse than this we don't trust PPS
+    static const int HDOP_MAX {300};
+    static const int SATS_MIN {4};
+
+    /*!
+     * \brief fix good enough to trust PPS (for clock servo)
+     *
+     * RMC valid, GGA read with fix, at least SATS_MIN satellites and HDOP up to
+     * HDOP_MAX; if GSA was read it must be 3D fix.
+     */
+    static bool fix_good()
+        {
+        if (!rmc_valid || (acquired & GGA_FL) == 0)
+            {
+            return false;
+            }
+
+        if (fix_quality < 1 || sats_used < SATS_MIN || hdop < 0 || hdop > HDOP_MAX)
+            {
+            return false;
+            }
+
+        return (acquired & GSA_FL) == 0 || fix_mode == 3;
+        }
+
+    static bool is_used(gnss::Sys sys, int prn)
+        {
+        return prn > 0 && prn <= gnss::PRN_NB && ((used[sys] >> (prn - 1)) & 1);
+        }
+
     inline static bool has_date_time()
         {
         return ((acquired & RCM_FLTD) == RCM_FLTD);
@@ -72,9 +137,25 @@ public:
         }
 
     static void read_data();
-    static void parse_sentences();
-    static bool check_what_sentence(const std::string_view &fields);
-    static bool parse_sentence(const std::vector<std::string_view>&);
+
+// streaming: bytes from UART4 idle event, decoded as they come
+    static NmeaStream stream;
+    static volatile bool epoch_open;
+
+    /*!
+     * \brief start to collect data of this second (streaming)
+     *
+     * Clears data of the last second, from now on decoded sentences are taken in,
+     * until read_data() closes.
+     */
+    static void begin_epoch();
+    static void stream_data(const uint8_t *data, int size)
+        {
+        stream.feed(data, size);
+        }
+    static void on_sentence(const NmeaFields &fields);
+
+    static bool parse_sentence(const NmeaFields &fields);
     static void update_strong();
 
 // check (not exact)
@@ -84,18 +165,6 @@ public:
                 && gps_day > 0 && gps_day < 32;
         }
 
-    static void save(int sz)
-        {
-        if ((gps_rx[0] == '$') && (sz > 50) && (sz < (RXSZ - 1)))
-            {
-            gps_rx[sz] = 0;
-            }
-        else
-            {
-            gps_rx[0] = 0;
-            }
-        }
-
     static bool time_valid()
         {
         return gps_hour > -1 && gps_hour < 60 && gps_minute > -1 && gps_minute < 60
@@ -110,74 +179,6 @@ public:
         {
         unset();
         }
-
-    /*!
-     * \brief counts MNEA check sum
-     *
-     * whole sentence (include $ and * must be send to the method
-     *
-     * \param s message to check
-     * \param size return pos. of '*' character, or -1
-     * \return check sum or -1 if syntax error
-     */
-    static int count_check_sum(const std::string_view &s, std::string::size_type &size)
-        {
-        int sum = 0;
-        size = -1;
-        int dollars_nb = 0;
-
-        for (std::string::size_type i = 0; i < s.length(); ++i)
-            {
-            char c = s[i];
-
-            if (c == '$')
-                {
-                ++dollars_nb;
-                if (dollars_nb > 1)
-                    {
-// pair $ and * don't match
-                    return -1;
-                    }
-
-                continue;
-                }
-
-            if (dollars_nb == 0)
-                {
-                continue;
-                }
-
-            if (c == '*')
-                {
-                size = i;
-                return sum;
-                }
-
-            sum ^= c;
-            }
-
-        return -1;
-        }
-
-    static bool cntrCheckSum(const std::string_view &s)
-        {
-        std::string::size_type sz = s.length();
-        std::string::size_type p = 0;
-
-        int csum = count_check_sum(s, p);
-        if (csum == -1) return false;
-
-        if (sz < (p + 3)) return false;
-
-// we have counted in 10, in s, control number is in hex, hex => 10
-        int ctr_sum = std::stoi(std::string(s.substr(p + 1, 2)), 0, 16);
-        if (csum != ctr_sum)
-            {
-            return false;
-            }
-
-        return true;
-        }
     };
 
 #endif /* GPS_H_ */
@@ -12,17 +12,75 @@
 #define SATELLITE_H_
 
 #include <vector>
-#include <map>
 #include <string>
 #include <cstdint>
 #include <cmath>
+#include <algorithm>
 #include "NDisplay.h"
+#include "NmeaTag.h"
+#include "SatRank.h"
+#include "SatTable.h"
+#include "SkyComp.h"
+#include "SkyLut.h"
 
 extern NDisplay display;
 
+namespace gnss
+{
+// satellite numbers of one system
+const int PRN_NB {64};
+
+/*!
+ * \brief NMEA satellite number to number in own system 1..PRN_NB
+ *
+ * GLONASS comes as 65..96 also from GP/GN talker, BeiDou and Galileo can come as
+ * 201.., 401.. and 301...
+ *
+ * \param sys system from talker ID, corrected if PRN says other
+ * \param prn NMEA number
+ * \return number in the system or 0 if not known
+ */
+inline int norm_prn(Sys &sys, int prn)
+    {
+    if (sys == GPS && prn > 64 && prn <= 96)
+        {
+        sys = GLONASS;
+        }
+
+    if (sys == GLONASS && prn > 64)
+        {
+        prn -= 64;
+        }
+    else if (sys == BEIDOU && prn > 400)
+        {
+        prn -= 400;
+        }
+    else if (sys == BEIDOU && prn > 200)
+        {
+        prn -= 200;
+        }
+    else if (sys == GALILEO && prn > 300)
+        {
+        prn -= 300;
+        }
+
+    return (prn > 0 && prn <= PRN_NB) ? prn : 0;
+    }
+
+// all satellites of all systems
+const int SAT_NB {SYS_NB * PRN_NB};
+
+// unique over all systems, satellites of one system follow each other
+inline int key(Sys sys, int prn)
+    {
+    return sys * PRN_NB + prn - 1;
+    }
+}
+
 struct GPSsat
     {
     uint8_t id;
+    uint8_t sys;
     uint8_t elevation;
     uint8_t SNR;
     uint8_t flag;
@@ -34,6 +92,7 @@ struct GPSsat
     GPSsat()
         {
         id = 0;
+        sys = gnss::GPS;
         elevation = 90;
         azimuth = 0;
         SNR = 0;
@@ -46,22 +105,33 @@ struct GPSsat
     GPSsat(const GPSsat &oth)
         {
         id = oth.id;
+        sys = oth.sys;
         elevation = oth.elevation;
         SNR = oth.SNR;
         azimuth = oth.azimuth;
-        xy_c(elevation, azimuth);
+        xo = oth.xo;
+        yo = oth.yo;
         flag = oth.flag;
         set_indx();
         }
 
-    GPSsat(uint8_t _id, uint8_t _elev, uint16_t _azim, uint8_t _snr) :
-            id(_id), elevation(_elev), SNR(_snr), azimuth(_azim)
+    // SatTable copies in place
+    GPSsat& operator=(const GPSsat &oth) = default;
+
+    GPSsat(uint8_t _id, uint8_t _elev, uint16_t _azim, uint8_t _snr,
+            uint8_t _sys = gnss::GPS) :
+            id(_id), sys(_sys), elevation(_elev), SNR(_snr), azimuth(_azim)
         {
         xy_c(_elev, _azim);
         flag = 0;
         set_indx();
         }
 
+    int key() const
+        {
+        return gnss::key((gnss::Sys) sys, id);
+        }
+
     // all but not id
     bool operator==(const GPSsat &oth) const
         {
@@ -73,11 +143,11 @@ struct GPSsat
         return (elevation != oth.elevation) || (azimuth != oth.azimuth);
         }
 
+    // tables, no float (see SkyLut.h)
     void xy_c(int alt, int azim)
         {
-        float r = R * (1 - (float) alt / 90.0);
-        xo = (int) std::round(r * sinf(D2R * azim) + X0);
-        yo = (int) std::round(Y0 - r * cosf(D2R * azim));
+        xo = sky::x(alt, azim);
+        yo = sky::y(alt, azim);
         }
 
     static int get_ix(int snr)
@@ -96,10 +166,9 @@ struct GPSsat
         indx = get_ix(SNR);
         }
 
-    static const int X0 {119};
-    static const int Y0 {122};
-    static const int R {109};
-    static constexpr float D2R {M_PI / 180};
+    static const int X0 {sky::X0};
+    static const int Y0 {sky::Y0};
+    static const int R {sky::R};
     static const uint8_t P {0b10};
     static const uint8_t E {0b01};
     static const uint8_t PE {0b11};
@@ -115,12 +184,6 @@ struct GPSsat
     };
 
 
-struct Strong
-    {
-    int id {0};
-    int snr {0};
-    };
-
 struct SVs
     {
     SVs() = default;
@@ -131,16 +194,50 @@ struct SVs
     static const int DCLR {-14};
     static const int WCLR {31};
 
-    static char buf[64];
+    // key is GPSsat::key(), i.e. grouped per system
+    typedef SatTable<GPSsat, gnss::SAT_NB> SatSet;
+    static SatSet old_spaceVehicles;
+    static SatSet new_spaceVehicles;
+
+    // for bars on page 1
+    static const int NB_STRONG {8};
+    static SatRank<NB_STRONG> strongest_sats;
+
+    // all keys of new_spaceVehicles, strongest first (display order, strongest on top)
+    static int z_order[gnss::SAT_NB];
+    static int z_nb;
+
+    /*!
+     * \brief fill z_order, counting sort on SNR (0..99), same SNR lower key first
+     */
+    static void sort_z()
+        {
+        static const int SNR_MAX {99};
+        // start of each SNR in z_order, SNR_MAX first
+        uint16_t st[SNR_MAX + 2] {};
+
+        for (int k : new_spaceVehicles)
+            {
+            ++st[SNR_MAX - new_spaceVehicles[k].SNR + 1];
+            }
+        for (int i = 1; i <= SNR_MAX + 1; ++i)
+            {
+            st[i] += st[i - 1];
+            }
+        // keys come in rising order => stable
+        for (int k : new_spaceVehicles)
+            {
+            z_order[st[SNR_MAX - new_spaceVehicles[k].SNR]++] = k;
+            }
 
-    static std::map<int, GPSsat> old_spaceVehicles;
-    static std::map<int, GPSsat> new_spaceVehicles;
-    static std::vector<Strong> strongest_sats;
+        z_nb = new_spaceVehicles.size();
+        }
 
-    static void erase_sat(const GPSsat &s, const NDisplay &disp)
+    static void erase_sat(const GPSsat &s)
         {
-        sprintf(buf, "picq %d,%d,%d,%d,0", s.xo + DCLR, s.yo + DCLR, WCLR, WCLR);
-        disp.sendCommand(buf);
+        NCmd cmd;
+        cmd.str("picq ").nums(s.xo + DCLR, s.yo + DCLR, WCLR, WCLR).chr('0');
+        SkyComp::send(cmd.view());
         }
 
     const static char *COLORS[4];
@@ -152,81 +249,44 @@ struct SVs
         return std::max(std::abs(a.xo - b.xo), std::abs(a.yo - b.yo));
         }
 
-    static void draw_sat(const GPSsat &s, const NDisplay &disp)
+    static void draw_sat(const GPSsat &s)
         {
-        sprintf(buf, "cirs %d,%d,14,%s", s.xo, s.yo, COLORS[s.indx]);
-        disp.sendCommand(buf);
-
-        sprintf(buf, "xstr %d,%d,%d,%d,4,BLACK,%s,1,1,1,\"%d\"", s.xo + DW, s.yo + DH, W,
-                W, COLORS[s.indx], s.id);
-        disp.sendCommand(buf);
+        NCmd cmd;
+        cmd.str("cirs ").nums(s.xo, s.yo, 14).str(COLORS[s.indx]);
+        SkyComp::send(cmd.view());
+
+        cmd.clear();
+        cmd.str("xstr ").nums(s.xo + DW, s.yo + DH, W, W, 4).str("BLACK,");
+        cmd.str(COLORS[s.indx]).str(",1,1,1,\"").num(s.id).chr('"');
+        SkyComp::send(cmd.view());
         }
 
-    // insert/update new sat/values and remove old ones, display them
-    static void update_sats()
+    /*!
+     * \brief call f(key) for every satellite stronger than z_order[i] and closer than
+     * WCLR to it
+     *
+     * All stronger ones are checked: up to 60 satellites this is faster than a grid
+     * (test/sky_grid_bench).
+     */
+    template<typename F>
+    static void near_stronger(int i, F f)
         {
-        // erase vanished satellites
-        //first, mark only
-        for (auto k_v : old_spaceVehicles)
-            {
-            if (!new_spaceVehicles.contains(k_v.first))
-                {
-                k_v.second.flag = GPSsat::E;
-                }
-            }
+        const GPSsat &s = new_spaceVehicles[z_order[i]];
 
-        // mark satellites for redrawing (if close to erase area or display order [
-        // strongest on top])
-        // go through all pair
-        for (auto im = old_spaceVehicles.begin(); im != old_spaceVehicles.end(); ++im)
+        for (int j = 0; j < i; ++j)
             {
-            auto ii = im;
-            ++ii;
-
-            for (; ii != old_spaceVehicles.end(); ++ii)
+            int n = z_order[j];
+            if (dist(s, new_spaceVehicles[n]) < WCLR)
                 {
-                if (((ii->second.flag & GPSsat::PE) == 0)
-                        && (dist(im->second, ii->second) >= WCLR))
-                    {
-                    ii->second.flag = GPSsat::P;
-                    im->second.flag = GPSsat::P;
-                    }
+                f(n);
                 }
             }
+        }
 
-        //  clear vanished satellites
-        auto it = old_spaceVehicles.begin();
-        while (it != old_spaceVehicles.end())
-            {
-            if (new_spaceVehicles.contains(it->first))
-                {
-                ++it;
-                }
-            else
-                {
-                erase_sat(it->second, display);
-                it = old_spaceVehicles.erase(it);
-                }
-            }
-
-        // repaint
-        for (auto i = strongest_sats.begin(); i != strongest_sats.end(); ++i)
-            {
-            if (old_spaceVehicles[i->id].has2clear())
-                {
-                erase_sat(old_spaceVehicles[i->id], display);
-                }
-            }
-
-        for (auto i = strongest_sats.rbegin(); i != strongest_sats.rend(); ++i)
-            {
-            if (old_spaceVehicles[i->id].has2paint())
-                {
-                draw_sat(new_spaceVehicles[i->id], display);
-                }
-
-            old_spaceVehicles[i->id] = new_spaceVehicles[i->id];
-            }
+    // insert/update new sat/values and remove old ones, display them
+    static void update_sats()
+        {
+        SkyComp::compose();
         }        //static void update_sats()
 
     };
@@ -15,6 +15,7 @@
 #include <string_view>
 
 int get_nd(const std::string_view &field, int pos, int n);
+int get_fix(const std::string_view &field, int decimals);
 
 inline bool read_check(const std::string_view &field, int minVal, int maxVal, int &v)
     {
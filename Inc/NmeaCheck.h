@@ -0,0 +1,91 @@
+/*!
+ * \file NmeaCheck.h
+ * \brief NMEA checksum: table hex decode and XOR a word (4 bytes) at a time.
+ *
+ * "$" and "*" are looked for in the whole word (SWAR), only the last word of a sentence
+ * is walked byte by byte. scan() checks a whole packet in one pass; NmeaStream keeps
+ * its XOR in the copy loop and shares the hex table.
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INC_NMEACHECK_H_
+#define INC_NMEACHECK_H_
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+namespace nmea
+{
+// value of hex digit, -1 if not a hex digit
+constexpr std::array<int8_t, 256> HEX = []
+    {
+        std::array<int8_t, 256> t {};
+        for (int i = 0; i < 256; ++i)
+            {
+            t[i] = -1;
+            }
+        for (int i = 0; i < 10; ++i)
+            {
+            t['0' + i] = i;
+            }
+        for (int i = 0; i < 6; ++i)
+            {
+            t['A' + i] = 10 + i;
+            t['a' + i] = 10 + i;
+            }
+        return t;
+    }();
+
+/*!
+ * \brief two hex digits to number
+ *
+ * \return 0..255 or -1 if not hex
+ */
+inline int hex2(char hi, char lo)
+    {
+    int h = HEX[(uint8_t) hi];
+    int l = HEX[(uint8_t) lo];
+
+    if ((h | l) < 0)
+        {
+        return -1;
+        }
+
+    return (h << 4) | l;
+    }
+
+/*!
+ * \brief XOR of bytes after '$' up to '*'
+ *
+ * \param s text which starts with '$'
+ * \param star returns position of '*'
+ * \return check sum or -1 if there is no '*' or a second '$' comes first
+ */
+int xor_sum(std::string_view s, std::string_view::size_type &star);
+
+/*!
+ * \brief check sentence "$...*hh", text in front of '$' is skipped
+ */
+bool check(std::string_view s);
+
+// valid sentence in a packet, '$' up to and incl. the check sum digits
+struct Span
+    {
+    uint16_t off;
+    uint16_t len;
+    };
+
+/*!
+ * \brief find and check all sentences in a packet in one pass
+ *
+ * \param packet many sentences
+ * \param out returns valid sentences
+ * \param max size of out
+ * \return number of valid sentences in out
+ */
+int scan(std::string_view packet, Span *out, int max);
+}
+
+#endif /* INC_NMEACHECK_H_ */
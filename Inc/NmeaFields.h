@@ -0,0 +1,82 @@
+/*!
+ * \file NmeaFields.h
+ * \brief Zero-allocation NMEA fields.
+ *
+ * Replaces the vectors of split() on the hot path: NmeaStream pushes the fields while
+ * it reads the bytes, as string_view into its line buffer, stored in a fixed array.
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INC_NMEAFIELDS_H_
+#define INC_NMEAFIELDS_H_
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+/*!
+ * \brief Fields of one NMEA sentence.
+ *
+ * Same rules as split() had: an empty field becomes "0", the checksum part (from '*')
+ * is not a field (NmeaStream doesn't push it).
+ */
+class NmeaFields
+    {
+public:
+    // 82 characters max. per sentence => never more than 40 commas
+    static const int MAX_FIELDS {40};
+
+    void clear()
+        {
+        nb = 0;
+        }
+
+    /*!
+     * \brief append one field (NmeaStream at each ',' and at '*')
+     *
+     * \return false if full
+     */
+    bool push(std::string_view f)
+        {
+        if (nb == MAX_FIELDS)
+            {
+            return false;
+            }
+
+        // null (empty) field best be expressed as zero
+        fields[nb++] = f.empty() ? std::string_view("0") : f;
+        return true;
+        }
+
+    int size() const
+        {
+        return nb;
+        }
+
+    bool empty() const
+        {
+        return nb == 0;
+        }
+
+    const std::string_view& operator[](int i) const
+        {
+        return fields[i];
+        }
+
+    const std::string_view* begin() const
+        {
+        return fields.data();
+        }
+
+    const std::string_view* end() const
+        {
+        return fields.data() + nb;
+        }
+
+private:
+    std::array<std::string_view, MAX_FIELDS> fields;
+    int nb {0};
+    };
+
+#endif /* INC_NMEAFIELDS_H_ */
@@ -0,0 +1,89 @@
+/*!
+ * \file NmeaStream.h
+ * \brief Byte-streaming NMEA parser.
+ *
+ * Bytes are fed as they come from the UART DMA idle event; a sentence is checked and
+ * handed over the moment its "\r\n" arrives. Sentences which straddle two idle events
+ * are not lost, the state survives between calls.
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INC_NMEASTREAM_H_
+#define INC_NMEASTREAM_H_
+
+#include <cstdint>
+#include "NmeaFields.h"
+
+class NmeaStream
+    {
+public:
+    /*!
+     * \brief called for every sentence with right checksum
+     *
+     * The fields point into the stream's line buffer, valid only during the call.
+     */
+    typedef void (*Handler)(const NmeaFields &fields);
+
+    // NMEA says 82 characters incl. "$" and "\r\n", some receivers go above
+    static const int MAX_LEN {96};
+
+    explicit NmeaStream(Handler _handler) :
+            handler(_handler)
+        {
+        }
+
+    /*!
+     * \brief consume bytes, may be called from interrupt
+     *
+     * \param data received bytes
+     * \param size number of bytes
+     */
+    void feed(const uint8_t *data, int size);
+
+    // start from scratch, next sentence starts with '$'
+    void reset()
+        {
+        state = HUNT;
+        }
+
+    uint32_t getSentences() const
+        {
+        return sentences;
+        }
+
+    uint32_t getErrors() const
+        {
+        return errors;
+        }
+
+private:
+    enum State
+        {
+        HUNT, BODY, CS_HI, CS_LO, END
+        };
+
+    void start();
+    bool addField();
+    void fail();
+    void done();
+
+    Handler handler;
+
+    State state {HUNT};
+    char line[MAX_LEN];
+    int len {0};
+    // start of current field in line
+    int fst {0};
+
+    // XOR of the body (made while it is copied), and the one from "*hh"
+    uint8_t sum {0};
+    uint8_t ctr {0};
+
+    NmeaFields fields;
+
+    uint32_t sentences {0};
+    uint32_t errors {0};
+    };
+
+#endif /* INC_NMEASTREAM_H_ */
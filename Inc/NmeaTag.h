@@ -0,0 +1,178 @@
+/*!
+ * \file NmeaTag.h
+ * \brief Sentence tag ("GPRMC", "GLGSV", ...) to talker system and sentence type.
+ *
+ * The 5 characters are packed in 25 bits, the table of known tags is hashed with a
+ * multiplier which the compiler finds so that there are no collisions (perfect hash),
+ * so lookup is one multiplication and one compare.
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INC_NMEATAG_H_
+#define INC_NMEATAG_H_
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+namespace gnss
+{
+enum Sys : uint8_t
+    {
+    GPS, GLONASS, GALILEO, BEIDOU, SYS_NB
+    };
+}
+
+namespace nmea
+{
+// handled sentence types, index to the handler table in GPS
+enum Type : uint8_t
+    {
+    RMC, GSV, GGA, GSA, TYPE_NB
+    };
+
+struct Tag
+    {
+    uint32_t code;
+    gnss::Sys sys;
+    Type type;
+    };
+
+// 'A'..'Z' in 5 bits each, 0 if not a tag
+constexpr uint32_t pack(std::string_view t)
+    {
+    if (t.size() != 5)
+        {
+        return 0;
+        }
+
+    uint32_t code = 0;
+    for (char c : t)
+        {
+        if (c < 'A' || c > 'Z')
+            {
+            return 0;
+            }
+        code = (code << 5) | (c - 'A' + 1);
+        }
+
+    return code;
+    }
+
+struct Talker
+    {
+    const char *id;
+    gnss::Sys sys;
+    };
+
+// GN (combined) RMC/GGA is the same as GP; GN GSV/GSA are sorted out by PRN or by
+// system ID field
+constexpr Talker TALKERS[] { {"GP", gnss::GPS}, {"GN", gnss::GPS}, {"GL", gnss::GLONASS}, {
+        "GA", gnss::GALILEO}, {"GB", gnss::BEIDOU}, {"BD", gnss::BEIDOU}};
+constexpr const char *TYPES[TYPE_NB] {"RMC", "GSV", "GGA", "GSA"};
+
+constexpr int TALKER_NB {sizeof(TALKERS) / sizeof(TALKERS[0])};
+constexpr int TAG_NB {TALKER_NB * TYPE_NB};
+
+constexpr std::array<Tag, TAG_NB> TAGS = []
+    {
+        std::array<Tag, TAG_NB> t {};
+        int n = 0;
+        for (const auto &tk : TALKERS)
+            {
+            for (int ty = 0; ty < TYPE_NB; ++ty)
+                {
+                char s[5] {tk.id[0], tk.id[1], TYPES[ty][0], TYPES[ty][1], TYPES[ty][2]};
+                t[n++] = {pack(std::string_view(s, 5)), tk.sys, (Type) ty};
+                }
+            }
+        return t;
+    }();
+
+constexpr int HASH_BITS {6};
+constexpr int HASH_SZ {1 << HASH_BITS};
+
+constexpr int hash(uint32_t code, uint32_t mul)
+    {
+    return (code * mul) >> (32 - HASH_BITS);
+    }
+
+constexpr uint32_t find_mul()
+    {
+    for (uint32_t mul = 0x9E3779B1; mul != 0x9E3779B1 + 100000; mul += 2)
+        {
+        bool used[HASH_SZ] {};
+        bool ok = true;
+        for (const auto &t : TAGS)
+            {
+            int h = hash(t.code, mul);
+            if (used[h])
+                {
+                ok = false;
+                break;
+                }
+            used[h] = true;
+            }
+        if (ok)
+            {
+            return mul;
+            }
+        }
+
+    return 0;
+    }
+
+constexpr uint32_t HASH_MUL {find_mul()};
+static_assert(HASH_MUL != 0, "no perfect hash for NMEA tags, make HASH_BITS bigger");
+
+// hash => index in TAGS, -1 empty
+constexpr std::array<int8_t, HASH_SZ> TAG_HASH = []
+    {
+        std::array<int8_t, HASH_SZ> t {};
+        for (auto &i : t)
+            {
+            i = -1;
+            }
+        for (int i = 0; i < TAG_NB; ++i)
+            {
+            t[hash(TAGS[i].code, HASH_MUL)] = i;
+            }
+        return t;
+    }();
+
+/*!
+ * \brief find the tag of a sentence
+ *
+ * \param field first field of sentence, with '$'
+ * \return the tag or nullptr if the sentence is not handled
+ */
+constexpr const Tag* find_tag(std::string_view field)
+    {
+    if (field.size() != 6 || field[0] != '$')
+        {
+        return nullptr;
+        }
+
+    uint32_t code = pack(field.substr(1));
+    if (code == 0)
+        {
+        return nullptr;
+        }
+
+    int i = TAG_HASH[hash(code, HASH_MUL)];
+    if (i < 0 || TAGS[i].code != code)
+        {
+        return nullptr;
+        }
+
+    return &TAGS[i];
+    }
+
+static_assert(find_tag("$GNRMC") != nullptr && find_tag("$GNRMC")->type == RMC);
+static_assert(find_tag("$GLGSV") != nullptr && find_tag("$GLGSV")->sys == gnss::GLONASS);
+static_assert(find_tag("$GPGGA") != nullptr && find_tag("$GPGGA")->type == GGA);
+static_assert(find_tag("$GPVTG") == nullptr);
+}
+
+#endif /* INC_NMEATAG_H_ */
@@ -0,0 +1,49 @@
+/*!
+ * \file PpsCapture.h
+ * \brief PPS time stamp latched by TIM2 input capture (channel 1).
+ *
+ * PPS stays on PA8 (EXTI), and a wire from PA8 to PA15 (CN7 pin 17, TIM2_CH1) gives the
+ * capture; PA0/PA1 are UART4 to the GPS board. PA15 is JTDI after reset, free with SWD.
+ * The counter is latched by the timer at the edge, interrupt latency doesn't matter.
+ * Without capture (no wire) the EXTI time stamp is used, as before.
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INC_PPSCAPTURE_H_
+#define INC_PPSCAPTURE_H_
+
+#include <cstdint>
+
+namespace ppscap
+{
+// seconds without capture before EXTI is used
+const int MISSING_MAX {2};
+
+// histogram of EXTI count - captured count (timer ticks), last bin also for more
+const int HIST_NB {64};
+extern uint32_t hist[HIST_NB];
+
+// seconds without capture
+extern volatile int missing;
+
+// PA15 as TIM2_CH1, capture on rising edge with interrupt
+void init();
+
+// capture is working, EXTI only measures
+inline bool active()
+    {
+    return missing < MISSING_MAX;
+    }
+
+// every second (TIM2 update)
+void tick();
+
+// time stamps of the same PPS from both interrupts, any order
+void from_capture(uint32_t cnt);
+void from_exti(uint32_t cnt);
+
+void print_hist();
+}
+
+#endif /* INC_PPSCAPTURE_H_ */
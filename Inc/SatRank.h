@@ -0,0 +1,104 @@
+/*!
+ * \file SatRank.h
+ * \brief The N strongest satellites, kept in order as they are updated.
+ *
+ * Order: SNR down, same SNR => lower key first, so bars don't swap places when two
+ * satellites have the same SNR.
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INC_SATRANK_H_
+#define INC_SATRANK_H_
+
+#include <array>
+
+struct Strong
+    {
+    int key {-1};   // GPSsat::key(), -1 empty place
+    int id {0};
+    int snr {0};
+
+    // a before b in the ranking
+    bool before(const Strong &b) const
+        {
+        return snr > b.snr || (snr == b.snr && key < b.key);
+        }
+    };
+
+/*!
+ * \brief Template: top N by SNR, updated in place.
+ */
+template<int N>
+class SatRank
+    {
+public:
+    // start of new second
+    void clear()
+        {
+        nb = 0;
+        }
+
+    /*!
+     * \brief insert or update one satellite
+     *
+     * A satellite which drops out of the N is forgotten; every satellite comes once a
+     * second, so that is OK.
+     */
+    void update(const Strong &s)
+        {
+        // already in? take it out first
+        for (int i = 0; i < nb; ++i)
+            {
+            if (rank[i].key == s.key)
+                {
+                for (int j = i; j < nb - 1; ++j)
+                    {
+                    rank[j] = rank[j + 1];
+                    }
+                --nb;
+                break;
+                }
+            }
+
+        int pos = nb;
+        while (pos > 0 && s.before(rank[pos - 1]))
+            {
+            --pos;
+            }
+
+        if (pos == N)
+            {
+            return;
+            }
+
+        int last = nb < N ? nb : N - 1;
+        for (int j = last; j > pos; --j)
+            {
+            rank[j] = rank[j - 1];
+            }
+        rank[pos] = s;
+
+        if (nb < N)
+            {
+            ++nb;
+            }
+        }
+
+    int size() const
+        {
+        return nb;
+        }
+
+    // place i, empty Strong (key -1) after size()
+    Strong operator[](int i) const
+        {
+        return i < nb ? rank[i] : Strong();
+        }
+
+private:
+    std::array<Strong, N> rank;
+    int nb {0};
+    };
+
+#endif /* INC_SATRANK_H_ */
@@ -0,0 +1,151 @@
+/*!
+ * \file SatTable.h
+ * \brief Fixed capacity table indexed directly by key, with presence bitmap.
+ *
+ * No heap: insert, erase, contains, lookup are O(1), clear is O(N/32). Iteration goes
+ * over present keys only, in rising order.
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INC_SATTABLE_H_
+#define INC_SATTABLE_H_
+
+#include <array>
+#include <bit>
+#include <cstdint>
+
+/*!
+ * \brief Template: table of T for keys 0..N-1.
+ */
+template<typename T, int N>
+class SatTable
+    {
+    static const int WORDS {(N + 31) / 32};
+
+public:
+    /*!
+     * \brief gives present keys, the current one may be erased while iterating
+     */
+    class iterator
+        {
+    public:
+        iterator(const SatTable *_t, int _w) :
+                t(_t), w(_w)
+            {
+            if (w < WORDS)
+                {
+                bits = t->bitmap[w];
+                }
+            next();
+            }
+
+        int operator*() const
+            {
+            return key;
+            }
+
+        iterator& operator++()
+            {
+            next();
+            return *this;
+            }
+
+        bool operator!=(const iterator &oth) const
+            {
+            return key != oth.key;
+            }
+
+    private:
+        void next()
+            {
+            while (bits == 0)
+                {
+                if (++w >= WORDS)
+                    {
+                    key = N;
+                    return;
+                    }
+                bits = t->bitmap[w];
+                }
+
+            int b = std::countr_zero(bits);
+            bits &= bits - 1;
+            key = w * 32 + b;
+            }
+
+        const SatTable *t;
+        int w;
+        uint32_t bits {0};
+        int key {N};
+        };
+
+    iterator begin() const
+        {
+        return iterator(this, 0);
+        }
+
+    iterator end() const
+        {
+        return iterator(this, WORDS);
+        }
+
+    bool contains(int key) const
+        {
+        return (bitmap[key >> 5] >> (key & 31)) & 1;
+        }
+
+    // the slot, present or not (no insert as map does)
+    T& operator[](int key)
+        {
+        return items[key];
+        }
+
+    const T& operator[](int key) const
+        {
+        return items[key];
+        }
+
+    // insert or overwrite
+    void insert(int key, const T &item)
+        {
+        items[key] = item;
+        if (!contains(key))
+            {
+            bitmap[key >> 5] |= (uint32_t) 1 << (key & 31);
+            ++nb;
+            }
+        }
+
+    void erase(int key)
+        {
+        if (contains(key))
+            {
+            bitmap[key >> 5] &= ~((uint32_t) 1 << (key & 31));
+            --nb;
+            }
+        }
+
+    void clear()
+        {
+        bitmap.fill(0);
+        nb = 0;
+        }
+
+    int size() const
+        {
+        return nb;
+        }
+
+    bool empty() const
+        {
+        return nb == 0;
+        }
+
+private:
+    std::array<T, N> items;
+    std::array<uint32_t, WORDS> bitmap {};
+    int nb {0};
+    };
+
+#endif /* INC_SATTABLE_H_ */
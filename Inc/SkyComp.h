@@ -0,0 +1,72 @@
+/*!
+ * \file SkyComp.h
+ * \brief Compositor for the sky plot: old and new frame => minimal Nextion commands.
+ *
+ * Erased areas (vanished and moved satellites) are collected as rectangles, overlapping
+ * ones are merged in one picq; every satellite touched by an erase or under a repainted
+ * weaker one is drawn once, weakest first (strongest on top).
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INC_SKYCOMP_H_
+#define INC_SKYCOMP_H_
+
+#include <cstdint>
+#include <string_view>
+
+struct GPSsat;
+
+struct Rect
+    {
+    int x {0};
+    int y {0};
+    int w {0};
+    int h {0};
+
+    int area() const
+        {
+        return w * h;
+        }
+
+    bool intersects(const Rect &o) const
+        {
+        return x < o.x + o.w && o.x < x + w && y < o.y + o.h && o.y < y + h;
+        }
+
+    Rect bbox(const Rect &o) const;
+    };
+
+class SkyComp
+    {
+public:
+    static const int MAX_RECT {32};
+
+    /*!
+     * \brief repaint the plot: SVs::old_spaceVehicles (flags set) => new_spaceVehicles
+     *
+     * At return old_spaceVehicles is the new frame.
+     */
+    static void compose();
+
+    // area which a satellite symbol takes (and which picq clears)
+    static Rect rect_of(const GPSsat &s);
+
+    // command to Nextion, counted
+    static void send(std::string_view cmd);
+
+    // bytes and commands sent to Nextion by last compose; all bytes, main loop zeroes
+    static uint32_t frame_bytes;
+    static uint32_t total_bytes;
+    static uint32_t frame_cmds;
+
+private:
+    static void add_erase(const Rect &r);
+    static void merge();
+    static bool damaged(const Rect &r);
+
+    static Rect erases[MAX_RECT];
+    static int nb_erase;
+    };
+
+#endif /* INC_SKYCOMP_H_ */
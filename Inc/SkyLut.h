@@ -0,0 +1,94 @@
+/*!
+ * \file SkyLut.h
+ * \brief Sky plot position of a satellite (elevation, azimuth) without float math.
+ *
+ * Radius (Q20) and sine (Q30) tables are made by the compiler, the product is done in
+ * 64 bits. This is exact: same as round() of the real value for all 91 x 360 inputs,
+ * also for the .5 cases (el. 0 and 45), where the old float formula could go wrong.
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INC_SKYLUT_H_
+#define INC_SKYLUT_H_
+
+#include <array>
+#include <cstdint>
+
+namespace sky
+{
+// plot centre and radius (elevation 0) in pixels
+const int X0 {119};
+const int Y0 {122};
+const int R {109};
+
+const int RAD_Q {20};
+const int SIN_Q {30};
+
+// sine of whole degree, Taylor series on 0..90 degrees, error < 1e-16
+constexpr double sin_deg(int d)
+    {
+    d %= 360;
+    if (d < 0) d += 360;
+    if (d >= 180) return -sin_deg(d - 180);
+    if (d > 90) d = 180 - d;
+
+    const double x = d * 3.14159265358979323846 / 180.0;
+    double term = x;
+    double sum = x;
+    for (int n = 1; n < 15; ++n)
+        {
+        term *= -x * x / ((2 * n) * (2 * n + 1));
+        sum += term;
+        }
+
+    return sum;
+    }
+
+constexpr std::array<int32_t, 360> SIN = []
+    {
+        std::array<int32_t, 360> t {};
+        for (int d = 0; d < 360; ++d)
+            {
+            double v = sin_deg(d) * (1 << SIN_Q);
+            t[d] = (int32_t) (v >= 0 ? v + 0.5 : v - 0.5);
+            }
+        return t;
+    }();
+
+// R * (90 - el) / 90, rounded in integers
+constexpr std::array<int32_t, 91> RAD = []
+    {
+        std::array<int32_t, 91> t {};
+        for (int el = 0; el <= 90; ++el)
+            {
+            t[el] = (int32_t) (((int64_t) R * (90 - el) * (2 << RAD_Q) + 90) / 180);
+            }
+        return t;
+    }();
+
+static_assert(SIN[30] == (1 << (SIN_Q - 1)) && SIN[90] == (1 << SIN_Q) && SIN[0] == 0);
+
+// floor(v + 0.5), i.e. round() in screen coordinates (always positive)
+inline int round_q(int64_t v)
+    {
+    const int SH {RAD_Q + SIN_Q};
+    return (int) ((v + ((int64_t) 1 << (SH - 1))) >> SH);
+    }
+
+// elevation 0..90, azimuth 0..359
+inline int x(int elev, int azim)
+    {
+    return X0 + round_q((int64_t) RAD[elev] * SIN[azim]);
+    }
+
+inline int y(int elev, int azim)
+    {
+    // cos(a) = sin(a + 90)
+    int c = azim + 90;
+    if (c >= 360) c -= 360;
+    return Y0 + round_q(-(int64_t) RAD[elev] * SIN[c]);
+    }
+}
+
+#endif /* INC_SKYLUT_H_ */
@@ -0,0 +1,100 @@
+/*!
+ * \file Stability.h
+ * \brief Streaming Allan, modified Allan and time deviation of the PPS phase.
+ *
+ * Octave averaging times tau = 1, 2, 4 ... 8192 s. Every level keeps the last two
+ * decimated phases and block averages and the sums of squared second differences:
+ * memory O(log tau), one sample costs 2 level updates on average.
+ * - ADEV: phase taken every tau s, AVAR = <(x2 - 2x1 + x0)^2> / (2 tau^2)
+ * - MDEV: the same with phase averaged over tau s blocks
+ * - TDEV = tau / sqrt(3) * MDEV
+ * Differences are not overlapped (stride tau), a gap in samples starts the chains
+ * again and keeps the sums. Phase in timer ticks, deviations in ticks/s and ticks.
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef INC_STABILITY_H_
+#define INC_STABILITY_H_
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+class Stability
+    {
+public:
+    static const int LEVELS {14};
+    // differences for a valid level
+    static const uint32_t MIN_N {32};
+
+    // \param f timer ticks in one second (for printing)
+    explicit Stability(double f) :
+            freq(f)
+        {
+        }
+
+    // phase of the next second [ticks]
+    void add(double x);
+
+    // samples missing or phase was set: differences over the gap are not made
+    void gap();
+
+    void clear();
+
+    static int tau(int k)
+        {
+        return 1 << k;
+        }
+
+    uint32_t count(int k) const
+        {
+        return lev[k].n;
+        }
+
+    // variances [(ticks/s)^2], 0 without data
+    double avar(int k) const;
+    double mvar(int k) const;
+
+    double adev(int k) const
+        {
+        return std::sqrt(avar(k));
+        }
+
+    double mdev(int k) const
+        {
+        return std::sqrt(mvar(k));
+        }
+
+    // [ticks]
+    double tdev(int k) const
+        {
+        return tau(k) * mdev(k) / std::sqrt(3.0);
+        }
+
+    // level of the smallest ADEV, -1 if no level is valid
+    int best_level() const;
+
+    // table: tau, n, ADEV and MDEV [1e-12], TDEV [ps]
+    void print() const;
+
+private:
+    struct Level
+        {
+        // last two phases and block averages, and how many of them
+        double x0, x1;
+        double a0, a1;
+        int filled;
+        // first half of the next level block
+        double xh, ah;
+        bool half;
+        // sums of squared second differences
+        double sa, sm;
+        uint32_t n;
+        };
+
+    std::array<Level, LEVELS> lev {};
+    double freq;
+    };
+
+#endif /* INC_STABILITY_H_ */
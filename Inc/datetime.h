@@ -16,6 +16,7 @@
 #define INC_DATIME_H_
 
 #include <string>
+#include <string_view>
 #include <tuple>
 
 extern const std::string L_TIME[3];
@@ -211,7 +212,14 @@ public:
         return del >= 0 ? lastDay : lastDay - 7;
         }
 
-    std::string getDateStr();
+    /*!
+     * \brief "Monday, January 1, 2025" made in buf (no heap), "" if date not set
+     *
+     * \param buf place for the text, 40 is enough
+     * \param size size of buf, longer text is cut
+     * \return the text in buf
+     */
+    std::string_view getDateStr(char *buf, int size) const;
 
 private:
     int sec = 0;   // 0..60 (60 if leaps sec)
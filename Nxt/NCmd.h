@@ -0,0 +1,75 @@
+/*
+ * \file NCmd.h
+ * \brief Nextion command made in a fixed buffer: no heap, no printf.
+ *
+ *  NCmd c;
+ *  c.str("cirs ").num(x).chr(',').num(y);
+ *  display.sendCommand(c.view());
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef NCMD_H_
+#define NCMD_H_
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <string_view>
+
+class NCmd
+    {
+public:
+    static const int SIZE {96};
+
+    NCmd& str(std::string_view s)
+        {
+        int n = std::min<int>(s.size(), SIZE - len);
+        std::memcpy(buf + len, s.data(), n);
+        len += n;
+        return *this;
+        }
+
+    NCmd& chr(char c)
+        {
+        if (len < SIZE)
+            {
+            buf[len++] = c;
+            }
+        return *this;
+        }
+
+    NCmd& num(int v)
+        {
+        auto res = std::to_chars(buf + len, buf + SIZE, v);
+        if (res.ec == std::errc())
+            {
+            len = res.ptr - buf;
+            }
+        return *this;
+        }
+
+    // list of numbers separated by ',', ends with ','
+    template<typename ... Args>
+    NCmd& nums(Args ... v)
+        {
+        ((num(v).chr(',')), ...);
+        return *this;
+        }
+
+    std::string_view view() const
+        {
+        return {buf, (size_t) len};
+        }
+
+    void clear()
+        {
+        len = 0;
+        }
+
+private:
+    char buf[SIZE];
+    int len {0};
+    };
+
+#endif /* NCMD_H_ */
@@ -14,47 +14,75 @@
 
 void NComp::setVal(int iOut) const
     {
-    display.setVal(key, iOut);
+    display.setVal(idx, iOut);
     }
 
-bool NComp::getVal(int &iIn) const
+// wait for the answer: requests time out in poll(), so this ends
+static bool wait_reply(NDisplay &display, NReply &reply)
     {
-    display.dataIn = false;
-    display.getVal(key);
+    while (reply.state == NReply::WAIT)
+        {
+        display.poll();
+        }
 
-    for (int i = 0; i < 10; ++i)
+    return reply.state == NReply::DONE;
+    }
+
+bool NComp::getVal(int &iIn) const
+    {
+    NReply reply;
+    if (!getValAsync(reply) || !wait_reply(display, reply))
         {
-        HAL_Delay(10);
-        if (display.dataIn)
-            {
-            iIn = display.NextNumBuff;
-            display.dataIn = false;
-            return true;
-            }
+        return false;
         }
-    return false;
+
+    iIn = reply.val;
+    return true;
     }
 
-void NComp::setText(const std::string &txtOut) const
+void NComp::invalidate() const
     {
-    display.setText(key, txtOut);
+    display.invalidateComp(idx);
     }
 
-bool NComp::getText(std::string &txtIn) const
+bool NComp::textShown() const
     {
-    display.dataIn = false;
-    display.getText(key);
+    return display.textShown(idx);
+    }
 
-    for (int i = 0; i < 10; ++i)
+void NComp::setText(std::string_view txtOut) const
+    {
+    display.setText(idx, txtOut);
+    }
+
+bool NComp::getText(std::string &txtIn) const
+    {
+    NReply reply;
+    if (!getTextAsync(reply) || !wait_reply(display, reply))
         {
-        HAL_Delay(10);
-        if (display.dataIn)
-            {
-            txtIn = display.NextTxtBuff;
-            display.dataIn = false;
-            return true;
-            }
+        return false;
         }
 
-    return false;
+    txtIn = reply.text();
+    return true;
+    }
+
+bool NComp::getValAsync(NReply &reply) const
+    {
+    return display.getAsync(idx, false, &reply, nullptr, nullptr);
+    }
+
+bool NComp::getTextAsync(NReply &reply) const
+    {
+    return display.getAsync(idx, true, &reply, nullptr, nullptr);
+    }
+
+bool NComp::getValAsync(NGetDone done, void *ctx) const
+    {
+    return display.getAsync(idx, false, nullptr, done, ctx);
+    }
+
+bool NComp::getTextAsync(NGetDone done, void *ctx) const
+    {
+    return display.getAsync(idx, true, nullptr, done, ctx);
     }
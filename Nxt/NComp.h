@@ -15,11 +15,40 @@
 #include <utility>
 #include <cinttypes>
 #include <string>
+#include <string_view>
 
 typedef std::pair<uint8_t, uint8_t> PnO_Id;
 
 class NDisplay;
 
+/*!
+ * \brief Answer to an asynchronous get, polled by the caller (a future).
+ *
+ * state is WAIT until the answer comes, then DONE or FAIL (timeout, wrong answer).
+ */
+struct NReply
+    {
+    enum State : uint8_t
+        {
+        IDLE, WAIT, DONE, FAIL
+        };
+
+    static const int TXT_SIZE {48};
+
+    volatile State state {IDLE};
+    int32_t val {0};
+    char txt[TXT_SIZE];
+    int len {0};
+
+    std::string_view text() const
+        {
+        return {txt, (size_t) len};
+        }
+    };
+
+// completion callback of asynchronous get, txt is valid only in the call
+typedef void (*NGetDone)(void *ctx, bool ok, int32_t val, std::string_view txt);
+
 class NComp
     {
 public:
@@ -29,17 +58,34 @@ public:
     friend class NDisplay;
 
     void setVal(int iIn) const;
+    void setText(std::string_view txtIn) const;
+    // next setVal/setText is sent (value on screen changed by Nextion itself)
+    void invalidate() const;
+    // the last setText is on screen (not invalidated since)
+    bool textShown() const;
+
+    // blocking get, waits up to NEXTION_TIMEOUT; not in work zone
     bool getVal(int &iOut) const;
-    void setText(const std::string &txtIn) const;
     bool getText(std::string &txtOut) const;
 
+    /*!
+     * \brief asynchronous get: the answer goes to reply or to the callback
+     *
+     * \return false if the request is not sent (too many in flight, ring full)
+     */
+    bool getValAsync(NReply &reply) const;
+    bool getTextAsync(NReply &reply) const;
+    bool getValAsync(NGetDone done, void *ctx = nullptr) const;
+    bool getTextAsync(NGetDone done, void *ctx = nullptr) const;
+
 private:
-    NComp(PnO_Id _key, NDisplay &_display) :
-            key(_key), display(_display)
+    NComp(uint8_t _idx, NDisplay &_display) :
+            idx(_idx), display(_display)
         {
         }
 
-    PnO_Id key;
+    // place in NDisplay::dObjects
+    uint8_t idx;
     NDisplay &display;
     };
 
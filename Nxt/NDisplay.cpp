@@ -9,45 +9,137 @@
  */
 
 #include "NDisplay.h"
+#include <algorithm>
+#include <cstring>
 #include <string_view>
 
 const int NDisplay::NEX_RET_EVENT_TOUCH_HEAD {0x65};
 const int NDisplay::NEX_RET_STRING_HEAD {0x70};
 const int NDisplay::NEX_RET_NUMBER_HEAD {0x71};
 const int NDisplay::NEX_RET_EVENT_WAKED {0x87};
-/*! \brief Support touch event, string data and numeric data
- *  </summary>
+const int NDisplay::NEX_RET_EVENT_LAUNCHED {0x88};
+// frame length for codes with binary data (which can have 0xff), 0 = up to 0xff 0xff 0xff
+static constexpr std::array<uint8_t, 256> FRAME_LEN = []
+    {
+        std::array<uint8_t, 256> t {};
+        t[0x65] = 7;    // touch: 0x65 page id event
+        t[0x66] = 5;    // page: 0x66 page
+        t[0x67] = 9;    // touch position: 0x67 x x y y event
+        t[0x68] = 9;    // same in sleep
+        t[0x71] = 8;    // number: 0x71 4 bytes
+        return t;
+    }();
+
+constexpr std::array<NDisplay::Handl, 256> NDisplay::HANDL = []
+    {
+        std::array<Handl, 256> t {};
+        t[NEX_RET_EVENT_TOUCH_HEAD] = &NDisplay::eventTouchHandl;
+        t[NEX_RET_STRING_HEAD] = &NDisplay::stringHeadHandl;
+        t[NEX_RET_NUMBER_HEAD] = &NDisplay::numberHeadHandl;
+        t[NEX_RET_EVENT_WAKED] = &NDisplay::eventWakedHandl;
+        t[NEX_RET_EVENT_LAUNCHED] = &NDisplay::eventLaunchedHandl;
+        for (int code :
+            {NEX_RET_INVALID_CMD, NEX_RET_INVALID_COMPONENT_ID, NEX_RET_INVALID_PAGE_ID,
+                    NEX_RET_INVALID_PICTURE_ID, NEX_RET_INVALID_FONT_ID, NEX_RET_INVALID_BAUD,
+                    NEX_RET_INVALID_VARIABLE, NEX_RET_INVALID_OPERATION,
+                    NEX_RET_ASSIGN_FAILED, NEX_RET_INVALID_PARAM_COUNT})
+            {
+            t[code] = &NDisplay::errorHandl;
+            }
+        return t;
+    }();
+
+/*! \brief Receive interrupt: bytes to rxRing, nothing more
  *
  *  <param name="_huart">handle UART</param>
  *  <param name="sz">number of red bytes</param>
- *
  */
 void NDisplay::processRx(UART_HandleTypeDef *_huart, int sz)
     {
-    // not real message, ignore
-    if (sz < 4)
+    (void) _huart;
+    uint32_t t0 = DWT->CYCCNT;
+    int head = rxHead;
+
+    for (int i = 0; i < sz; ++i)
         {
-        waitRxEvent();
-        return;
+        int next = (head + 1) % RX_RING;
+        if (next == rxTail)
+            {
+            rxOverrun = rxOverrun + (sz - i);
+            break;
+            }
+        rxRing[head] = RxData[i];
+        head = next;
         }
 
-    std::string_view sview(RxData, sz);
-    // find first pattern of 0xff 0xff 0xff
-    auto pos = sview.find("\xff\xff\xff");
-    if (pos == std::string_view::npos)
+    // data before index
+    __DMB();
+    rxHead = head;
+
+    waitRxEvent();
+
+    uint32_t cyc = DWT->CYCCNT - t0;
+    if (cyc > rxIsrMax)
         {
-        waitRxEvent();
-        return;
+        rxIsrMax = cyc;
         }
+    }
 
-    NextTextLen = pos;
-
-    if (eventHandl.contains(RxData[0]))
+/*! \brief Support touch event, string data and numeric data
+ *
+ * First whole frame of rxAcc is moved to frame (it's handled there, rxAcc can change in
+ * a callback which waits for a get answer). A frame cut by the idle event waits in rxAcc
+ * for the rest.
+ *
+ * \return false if there is no whole frame
+ */
+bool NDisplay::takeFrame(char *frame)
+    {
+    while (rxLen > 0)
         {
-        (this->*eventHandl[RxData[0]])();
+        std::string_view acc(rxAcc, rxLen);
+        uint8_t code = acc[0];
+        std::string_view::size_type end;
+
+        if (FRAME_LEN[code] != 0)
+            {
+            if (acc.size() < FRAME_LEN[code])
+                {
+                return false;
+                }
+            end = FRAME_LEN[code] - 3;
+            if (acc.substr(end, 3) != "\xff\xff\xff")
+                {
+                // not a frame: skip the byte and look for the next start
+                ++rxDropped;
+                std::memmove(rxAcc, rxAcc + 1, --rxLen);
+                continue;
+                }
+            }
+        else
+            {
+            end = acc.find("\xff\xff\xff");
+            if (end == std::string_view::npos)
+                {
+                if (rxLen == RX_ACC)
+                    {
+                    // garbage without end, start again
+                    rxDropped += rxLen;
+                    rxLen = 0;
+                    }
+                return false;
+                }
+            }
+
+        NextTextLen = end;
+        std::memcpy(frame, rxAcc, end);
+        rxLen -= end + 3;
+        std::memmove(rxAcc, rxAcc + end + 3, rxLen);
+
+        return true;
         }
 
-    waitRxEvent();
+    return false;
     }
 
 HAL_StatusTypeDef NDisplay::init(UART_HandleTypeDef *_uartHandle,
@@ -56,17 +148,18 @@ HAL_StatusTypeDef NDisplay::init(UART_HandleTypeDef *_uartHandle,
     p_uartHandle = _uartHandle;
     p_dmaHandle = _dmaHandle;
 
-    eventHandl[NEX_RET_EVENT_TOUCH_HEAD] = &NDisplay::eventTouchHandl;
-    eventHandl[NEX_RET_STRING_HEAD] = &NDisplay::stringHeadHandl;
-    eventHandl[NEX_RET_NUMBER_HEAD] = &NDisplay::numberHeadHandl;
-    eventHandl[NEX_RET_EVENT_WAKED] = &NDisplay::eventWakedHandl;
+    // cycle counter for blocked time
+    CoreDebug->DEMCR = CoreDebug->DEMCR | CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL = DWT->CTRL | DWT_CTRL_CYCCNTENA_Msk;
+
+    invalidate();
 
     //Start UART transaction using Idle and DMA
     return waitRxEvent();
     }
 
 /*!
- * \brief Add object to map<{{pNo,id}, object}
+ * \brief Add object to dObjects and to touch table [page][id]
  *
  * \param _page page No where Nextion object lives
  * \param _id id of object
@@ -78,48 +171,621 @@ HAL_StatusTypeDef NDisplay::init(UART_HandleTypeDef *_uartHandle,
 NComp NDisplay::addComp(uint8_t _page, uint8_t _id, const std::string &_objname,
         void (*_callbackOnPress)(), void (*_callbackOnRelease)())
     {
-    NObject nxtObj(_page, _id, _objname, _callbackOnPress, _callbackOnRelease);
-    PnO_Id key {_page, _id};
-    dObjects[key] = nxtObj;
+    bool touch = _page < MAX_PAGE && _id < MAX_ID;
+
+    // same page and id again: object replaced, index kept
+    if (touch && touchIdx[_page][_id] != 0)
+        {
+        uint8_t idx = touchIdx[_page][_id] - 1;
+        dObjects[idx] = NObject(_page, _id, _objname, _callbackOnPress,
+                _callbackOnRelease);
+        return NComp(idx, *this);
+        }
+
+    if (nbObj == MAX_COMP)
+        {
+        // NComp with no object, its commands are ignored; make MAX_COMP bigger
+        return NComp(MAX_COMP, *this);
+        }
+
+    uint8_t idx = nbObj++;
+    dObjects[idx] = NObject(_page, _id, _objname, _callbackOnPress, _callbackOnRelease);
+
+    if (touch)
+        {
+        touchIdx[_page][_id] = idx + 1;
+        }
 
-    NComp nc(key, *this);
+    NComp nc(idx, *this);
 
     return nc;
     }
 
-void NDisplay::setVal(PnO_Id key, int iOut)
+void NDisplay::setVal(uint8_t idx, int iOut)
+    {
+    if (idx >= nbObj)
+        {
+        return;
+        }
+
+    Shown &sh = shown[idx];
+    if (sh.valOk && sh.val == iOut)
+        {
+        ++cmdSuppressed;
+        return;
+        }
+
+    if (armState == ARM_FILL)
+        {
+        armComps |= (uint64_t) 1 << idx;
+        }
+
+    NCmd cmd;
+    // lost command => not on screen
+    sh.valOk = sendCommand(cmd.str(dObjects[idx].valPre).num(iOut).view());
+    sh.val = iOut;
+    ++cmdSent;
+    }
+
+// us between two DWT counts
+static uint32_t cyc2us(uint32_t cycles)
     {
-    std::sprintf(TxData, "%s.val=%d", dObjects[key].objname.c_str(), iOut);
-    sendCommand(TxData);
+    return cycles / (SystemCoreClock / 1000000);
     }
 
-void NDisplay::sendCommand(const std::string &_command) const
+// interrupts off, previous state back at the end of scope
+struct IrqLock
     {
-    static uint8_t END_MSG[3] {0xff, 0xff, 0xff};
-    HAL_UART_Transmit(p_uartHandle, (uint8_t*) _command.c_str(), _command.size(),
-            NEXTION_TIMEOUT); //½
+    uint32_t primask;
+
+    IrqLock() :
+            primask(__get_PRIMASK())
+        {
+        __disable_irq();
+        }
+
+    ~IrqLock()
+        {
+        __set_PRIMASK(primask);
+        }
+    };
+
+bool NDisplay::sendCommand(std::string_view _command)
+    {
+    static const uint8_t END_MSG[3] {0xff, 0xff, 0xff};
+    uint32_t t0 = DWT->CYCCNT;
+    int len = _command.size();
+
+    if (armState == ARM_FILL)
+        {
+        if (armLen + len + 3 > ARM_SIZE)
+            {
+            ++txFull;
+            return false;
+            }
+
+        std::memcpy(armBuf + armLen, _command.data(), len);
+        std::memcpy(armBuf + armLen + len, END_MSG, 3);
+        armLen += len + 3;
+        txBytes += len + 3;
+        ++armCmds;
+        return true;
+        }
+
+#ifdef NXT_TX_BLOCKING
+    HAL_UART_Transmit(p_uartHandle, (uint8_t*) _command.data(), len, NEXTION_TIMEOUT);
     HAL_UART_Transmit(p_uartHandle, END_MSG, 3, NEXTION_TIMEOUT);
+    txBytes += len + 3;
+    txCmds = txCmds + 1;
+    txBlockedUs = txBlockedUs + cyc2us(DWT->CYCCNT - t0);
+
+    return true;
+#else
+    for (uint32_t start = HAL_GetTick();;)
+        {
+            {
+            // reserve and fill at once, interrupt can send too
+            IrqLock lock;
+            uint8_t *p = txReserve(len + 3);
+            if (p != nullptr)
+                {
+                std::memcpy(p, _command.data(), len);
+                std::memcpy(p + len, END_MSG, 3);
+                txHead = txHead + len + 3;
+                txBytes += len + 3;
+                txCmds = txCmds + 1;
+                ++curCmds;
+                curBytes += len + 3;
+                txKick();
+                break;
+                }
+
+            // ring full of an open batch: send what is there, or nothing comes free
+            txStart();
+            }
+
+        // full: in main loop wait for DMA, in interrupt nothing comes free
+        if (__get_IPSR() != 0 || HAL_GetTick() - start >= NEXTION_TIMEOUT)
+            {
+            ++txFull;
+            txBlockedUs = txBlockedUs + cyc2us(DWT->CYCCNT - t0);
+            return false;
+            }
+        }
+
+    txBlockedUs = txBlockedUs + cyc2us(DWT->CYCCNT - t0);
+    return true;
+#endif
+    }
+
+// place for n bytes at txHead, head moves in sendCommand after the copy; interrupts off
+uint8_t* NDisplay::txReserve(int n)
+    {
+    if (txHead == txTail && txBusy == 0)
+        {
+        // empty, start from bottom: most place in one piece
+        txHead = 0;
+        txTail = 0;
+        txWrap = TX_RING;
+        }
+
+    if (txHead >= txTail)
+        {
+        if (txHead + n <= TX_RING)
+            {
+            return &txRing[txHead];
+            }
+
+        // top is too small, go round (head == tail would look empty => <)
+        if (n < txTail)
+            {
+            txWrap = txHead;
+            txHead = 0;
+            return txRing;
+            }
+
+        return nullptr;
+        }
+
+    return txHead + n < txTail ? &txRing[txHead] : nullptr;
+    }
+
+// start DMA on queued data, not in a batch; interrupts off
+void NDisplay::txKick()
+    {
+    if (txBatch == 0)
+        {
+        txStart();
+        }
+    }
+
+void NDisplay::txStart()
+    {
+    if (txBusy != 0)
+        {
+        return;
+        }
+
+    // armed frame fired => it is first
+    if (armState == ARM_WAIT)
+        {
+        armState = ARM_SENDING;
+        txBusy = armLen;
+        if (HAL_UART_Transmit_DMA(p_uartHandle, (uint8_t*) armBuf, armLen) != HAL_OK)
+            {
+            // too late to try again: the frame belongs to this second
+            txBusy = 0;
+            ++armLost;
+            forgetArmed();
+            return;
+            }
+        txCmds = txCmds + armCmds;
+        return;
+        }
+
+    if (txHead < txTail && txTail == txWrap)
+        {
+        txTail = 0;
+        txWrap = TX_RING;
+        }
+
+    int n = txHead >= txTail ? txHead - txTail : txWrap - txTail;
+    if (n == 0)
+        {
+        return;
+        }
+
+    txBusy = n;
+    if (HAL_UART_Transmit_DMA(p_uartHandle, &txRing[txTail], n) != HAL_OK)
+        {
+        // UART busy by blocking transmit? try again at next command
+        txBusy = 0;
+        }
     }
 
-void NDisplay::getVal(PnO_Id key)
+void NDisplay::processTx(UART_HandleTypeDef *_huart)
     {
-    sprintf(TxData, "get %s.val", dObjects[key].objname.c_str());
-    sendCommand(TxData);
+    (void) _huart;
+    IrqLock lock;
+
+    if (armState == ARM_SENDING)
+        {
+        uint32_t us = cyc2us(DWT->CYCCNT - armT0);
+        ++armLatency[std::min<int>(us / LAT_BIN_US, LAT_BINS - 1)];
+        armLatMax = std::max(armLatMax, us);
+        armState = ARM_IDLE;
+        }
+    else
+        {
+        txTail = txTail + txBusy;
+        }
+
+    txBusy = 0;
+    if (txHead < txTail && txTail == txWrap)
+        {
+        txTail = 0;
+        txWrap = TX_RING;
+        }
+
+    if (armState == ARM_WAIT)
+        {
+        // also in a batch
+        txStart();
+        }
+    else
+        {
+        txKick();
+        }
     }
 
-void NDisplay::setText(PnO_Id key, const std::string &txtOut)
+void NDisplay::txError()
     {
-    std::sprintf(TxData, "%s.txt=\"%s\"", dObjects[key].objname.c_str(), txtOut.c_str());
-    sendCommand(TxData);
+    IrqLock lock;
+
+    ++txErrors;
+    if (armState == ARM_SENDING)
+        {
+        // late now, as when its DMA doesn't start
+        ++armLost;
+        forgetArmed();
+        }
+
+    // tail didn't move: the part goes again (a command cut on the line gets one error
+    // answer, the next ones are whole)
+    txBusy = 0;
+    txStart();
     }
 
-//If the received package contains string data
-void NDisplay::getText(PnO_Id key)
+bool NDisplay::beginArm()
     {
-    std::sprintf(TxData, "get %s.txt", dObjects[key].objname.c_str());
-    sendCommand(TxData);
+#ifdef NXT_TX_BLOCKING
+    return false;
+#else
+    IrqLock lock;
+
+    if (armState == ARM_WAIT || armState == ARM_SENDING)
+        {
+        return false;
+        }
+
+    if (armState == ARMED)
+        {
+        disarm();
+        }
+
+    armLen = 0;
+    armCmds = 0;
+    armComps = 0;
+    armState = ARM_FILL;
+
+    return true;
+#endif
     }
 
+void NDisplay::endArm()
+    {
+    if (armState == ARM_FILL)
+        {
+        armState = armLen > 0 ? ARMED : ARM_IDLE;
+        }
+    }
+
+void NDisplay::fireArmed()
+    {
+    IrqLock lock;
+
+    if (armState != ARMED)
+        {
+        return;
+        }
+
+    armT0 = DWT->CYCCNT;
+    armState = ARM_WAIT;
+    txStart();
+    }
+
+void NDisplay::disarm()
+    {
+    IrqLock lock;
+
+    if (armState != ARMED && armState != ARM_FILL)
+        {
+        return;
+        }
+
+    forgetArmed();
+    }
+
+// values of the armed frame are not on screen
+void NDisplay::forgetArmed()
+    {
+    for (int i = 0; i < nbObj; ++i)
+        {
+        if ((armComps >> i) & 1)
+            {
+            shown[i].valOk = false;
+            shown[i].txtOk = false;
+            }
+        }
+
+    armState = ARM_IDLE;
+    }
+
+void NDisplay::beginBatch()
+    {
+    IrqLock lock;
+
+    if (txBatch == 0)
+        {
+        curCmds = 0;
+        curBytes = 0;
+        }
+    txBatch = txBatch + 1;
+    }
+
+void NDisplay::commitBatch()
+    {
+    IrqLock lock;
+
+    if (txBatch == 0)
+        {
+        return;
+        }
+
+    txBatch = txBatch - 1;
+    if (txBatch > 0)
+        {
+        return;
+        }
+
+    batchCmds = curCmds;
+    batchBytes = curBytes;
+    txStart();
+    }
+
+bool NDisplay::flush(uint32_t timeout)
+    {
+    uint32_t t0 = DWT->CYCCNT;
+    uint32_t start = HAL_GetTick();
+
+        {
+        // also an open batch goes out
+        IrqLock lock;
+        txStart();
+        }
+
+    while (txBusy != 0 || txHead != txTail)
+        {
+        if (txBusy == 0)
+            {
+            // DMA didn't start (UART busy), again
+            IrqLock lock;
+            txStart();
+            }
+
+        if (__get_IPSR() != 0 || HAL_GetTick() - start >= timeout)
+            {
+            return false;
+            }
+        }
+
+    txBlockedUs = txBlockedUs + cyc2us(DWT->CYCCNT - t0);
+    return true;
+    }
+
+
+void NDisplay::setText(uint8_t idx, std::string_view txtOut)
+    {
+    if (idx >= nbObj)
+        {
+        return;
+        }
+
+    // FNV-1a
+    uint32_t h = 2166136261u;
+    for (char c : txtOut)
+        {
+        h = (h ^ (uint8_t) c) * 16777619u;
+        }
+
+    Shown &sh = shown[idx];
+    if (sh.txtOk && sh.txt == h)
+        {
+        ++cmdSuppressed;
+        return;
+        }
+
+    if (armState == ARM_FILL)
+        {
+        armComps |= (uint64_t) 1 << idx;
+        }
+
+    NCmd cmd;
+    sh.txtOk = sendCommand(cmd.str(dObjects[idx].txtPre).str(txtOut).chr('"').view());
+    sh.txt = h;
+    ++cmdSent;
+    }
+
+// request in FIFO, then the command: the answer can't come before it's waited for
+bool NDisplay::getAsync(uint8_t idx, bool text, NReply *reply, NGetDone done, void *ctx)
+    {
+    if (idx >= nbObj)
+        {
+        return false;
+        }
+
+        {
+        IrqLock lock;
+        if (pendNb == MAX_PENDING)
+            {
+            return false;
+            }
+
+        pending[(pendHead + pendNb) % MAX_PENDING] = {text, HAL_GetTick(), txCmds, reply,
+                done, ctx};
+        pendNb = pendNb + 1;
+        if (reply != nullptr)
+            {
+            reply->state = NReply::WAIT;
+            }
+        }
+
+    NCmd cmd;
+    cmd.str("get ").str(dObjects[idx].objname).str(text ? ".txt" : ".val");
+    if (!sendCommand(cmd.view()))
+        {
+        // not sent, take back (answers only take from the head)
+        IrqLock lock;
+        pendNb = pendNb - 1;
+        if (reply != nullptr)
+            {
+            reply->state = NReply::FAIL;
+            }
+        return false;
+        }
+
+    return true;
+    }
+
+// take the oldest request; only if it's too old when timedOut
+bool NDisplay::popPending(Pending &p, bool timedOut)
+    {
+    IrqLock lock;
+
+    if (pendNb == 0)
+        {
+        return false;
+        }
+
+    if (timedOut && HAL_GetTick() - pending[pendHead].sent <= NEXTION_TIMEOUT)
+        {
+        return false;
+        }
+
+    p = pending[pendHead];
+    pendHead = (pendHead + 1) % MAX_PENDING;
+    pendNb = pendNb - 1;
+
+    return true;
+    }
+
+// answer of the oldest request
+void NDisplay::complete(bool text, bool ok, int32_t val, std::string_view txt)
+    {
+    Pending p;
+
+    // else answer to nobody (timed out before)
+    if (popPending(p, false))
+        {
+        cmdsDone = p.cmdsBefore + 1;
+        // text for number or opposite: the order is lost, this one fails
+        deliver(p, ok && p.text == text, val, txt);
+        }
+    }
+
+void NDisplay::deliver(const Pending &p, bool ok, int32_t val, std::string_view txt)
+    {
+    if (p.reply != nullptr)
+        {
+        p.reply->val = val;
+        p.reply->len = std::min<int>(txt.size(), (int) NReply::TXT_SIZE);
+        std::memcpy(p.reply->txt, txt.data(), p.reply->len);
+        p.reply->state = ok ? NReply::DONE : NReply::FAIL;
+        }
+
+    if (p.done != nullptr)
+        {
+        p.done(p.ctx, ok, val, txt);
+        }
+    }
+
+void NDisplay::poll()
+    {
+    char frame[RX_ACC];
+
+    for (;;)
+        {
+        // from interrupt ring to parser
+        int head = rxHead;
+        __DMB();
+        while (rxTail != head && rxLen < RX_ACC)
+            {
+            rxAcc[rxLen++] = rxRing[rxTail];
+            rxTail = (rxTail + 1) % RX_RING;
+            }
+
+        if (!takeFrame(frame))
+            {
+            break;
+            }
+
+        rxFrame = frame;
+        ++rxFrames;
+        uint8_t code = frame[0];
+        if (HANDL[code] != nullptr)
+            {
+            (this->*HANDL[code])();
+            }
+        }
+
+    Pending p;
+
+    while (popPending(p, true))
+        {
+        // what was before it is done or lost too
+        cmdsDone = p.cmdsBefore + 1;
+        ++getTimeouts;
+        deliver(p, false, 0, {});
+        }
+    }
+
+void NDisplay::invalidateComp(uint8_t idx)
+    {
+    if (idx < nbObj)
+        {
+        shown[idx].valOk = false;
+        shown[idx].txtOk = false;
+        }
+    }
+
+bool NDisplay::textShown(uint8_t idx) const
+    {
+    return idx < nbObj && shown[idx].txtOk;
+    }
+
+void NDisplay::invalidate(int page)
+    {
+    for (int i = 0; i < nbObj; ++i)
+        {
+        if (page < 0 || dObjects[i].pNO_id.first == page)
+            {
+            shown[i].valOk = false;
+            shown[i].txtOk = false;
+            }
+        }
+    }
+
+
 // touch     code page id   event
 // expected: 0x65 0xPa 0xId 0xEv 0xFF 0xFF 0xFF
 void NDisplay::eventTouchHandl()
@@ -130,30 +796,35 @@ void NDisplay::eventTouchHandl()
         }
 
     //In case of a touch event call the callback function accordingly.
-    PnO_Id p_id {RxData[1], RxData[2]};
+    uint8_t page = rxFrame[1];
+    uint8_t id = rxFrame[2];
 
-    if (dObjects.contains(p_id))
+    if (page >= MAX_PAGE || id >= MAX_ID || touchIdx[page][id] == 0)
         {
-        //Call the desired On Press or On Release callback function,
-        if (RxData[3] == PRESS)
-            {
-            if (dObjects.at(p_id).callbackOnPress != nullptr)
-                {
-                dObjects.at(p_id).callbackOnPress();
-                }
-            }
-        else if (RxData[3] == RELEASE && dObjects.at(p_id).callbackOnRelease != nullptr)
+        return;
+        }
+
+    const NObject &obj = dObjects[touchIdx[page][id] - 1];
+
+    //Call the desired On Press or On Release callback function,
+    if (rxFrame[3] == PRESS)
+        {
+        if (obj.callbackOnPress != nullptr)
             {
-            dObjects.at(p_id).callbackOnRelease();
+            obj.callbackOnPress();
             }
         }
+    else if (rxFrame[3] == RELEASE && obj.callbackOnRelease != nullptr)
+        {
+        obj.callbackOnRelease();
+        }
     }
 
+// 0x70 text 0xFF 0xFF 0xFF
+// Returned when get command to return a string
 void NDisplay::stringHeadHandl()
     {
-    NextTxtBuff.assign(&RxData[1], NextTextLen - 1);
-    // flag, (we use dma read, no blocking [asynchronous], main loop has to inform
-    dataIn = true;
+    complete(true, true, 0, std::string_view(&rxFrame[1], NextTextLen - 1));
     }
 
 // 0x71 0x01 0x02 0x03 0x04 0xFF 0xFF 0xFF
@@ -163,21 +834,56 @@ void NDisplay::numberHeadHandl()
     if (NextTextLen == 5)
         {
         //in little endian order: (0x01 + 0x02*256 + 0x03*65536 + 0x04*16777216)
-        NextNumBuff = RxData[1] | (RxData[2] << 8) | ((uint32_t) RxData[3] << 16)
-                | ((uint32_t) RxData[4] << 24);
-        dataIn = true;
+        const uint8_t *p = (const uint8_t*) rxFrame;
+        int32_t val = p[1] | (p[2] << 8) | ((uint32_t) p[3] << 16)
+                | ((uint32_t) p[4] << 24);
+        complete(false, true, val, {});
         }
     }
-// not implemented
+// in sleep mode setVal doesn't work, values sent then are not on screen
 void NDisplay::eventWakedHandl()
     {
 // auto wake up
     if (NextTextLen == 1)
         {
-// TODO: define a  method ½
+        invalidate();
         }
     }
 
+// Nextion (re)started, all pages show their defaults
+void NDisplay::eventLaunchedHandl()
+    {
+    if (NextTextLen == 1)
+        {
+        invalidate();
+        }
+    }
+
+// 0x1A 0xFF 0xFF 0xFF (and the other error codes): the command failed, e.g. get of a
+// name not on the page. Only failures are answered (bkcmd=2, default), so it is the
+// answer of the oldest get when no other command was sent between the last answered
+// get and it; without it that get would hold the queue till time out. Else a setVal
+// before it may have failed: the get waits for its own answer (or time out).
+void NDisplay::errorHandl()
+    {
+    // 0x00 0x00 0x00 at Nextion start is not an error
+    if (NextTextLen != 1)
+        {
+        return;
+        }
+
+        {
+        IrqLock lock;
+        if (pendNb == 0 || pending[pendHead].cmdsBefore != cmdsDone)
+            {
+            ++cmdErrors;
+            return;
+            }
+        }
+
+    complete(false, false, 0, {});
+    }
+
 // 0x01 0xFF 0xFF 0xFF
 // NEX_RET_CMD_FINISHED:
 
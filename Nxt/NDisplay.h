@@ -31,18 +31,25 @@
  * thup    Auto Wake on Touch: thup=0 (do not wake), thup=1 (wake on touch)
  *---
  * Observation: when in sleep mode setVal does't work
+ ***********************************************************************
+ *  Transmit: commands go to a ring (payload + 0xff 0xff 0xff together) which is sent
+ *  by USART3 TX DMA, the next part starts in HAL_UART_TxCpltCallback -> processTx.
+ *  CubeMX: USART3_TX needs a DMA stream (DMA1 Stream 3, channel 4), normal mode.
+ *  With NXT_TX_BLOCKING defined the old blocking HAL_UART_Transmit is used, the
+ *  blocked time is counted in both cases (txBlockedUs) for comparison.
  */
 
 #ifndef NDISPLAY_H_
 #define NDISPLAY_H_
 
+#include <array>
 #include <string>
-#include <map>
-#include <functional>
+#include <string_view>
 //Include HAL Library from main header file
 #include "main.h"
 #include "NObject.h"
 #include "NComp.h"
+#include "NCmd.h"
 
 class NDisplay
     {
@@ -51,7 +58,8 @@ class NDisplay
 public:
     /*!
      * \fn void processRx(UART_HandleTypeDef*, int)
-     * \brief This method parses data from Nextion and performs commands
+     * \brief Interrupt part of receive: only copies the bytes for poll() and restarts
+     * the DMA.
      * \param _huart Handle for UART.
      * \param _size Nubmer of bytes in RX buffer.
      */
@@ -99,18 +107,168 @@ public:
             void (*_callbackOnPress)()= nullptr, void (*_callbackOnRelease)()= nullptr);
 
     /*!
-     * \fn void sendCommand(const std::string&) const
-     * \brief The method sends commands to Nextion.
+     * \fn bool sendCommand(std::string_view)
+     * \brief The method queues command to Nextion, it is sent by DMA.
      *
+     * If the ring is full, it waits for place up to NEXTION_TIMEOUT (not in interrupt).
      * \param _command string with command
+     * \return false if command is lost (ring full), counted in txFull
+     */
+    bool sendCommand(std::string_view _command);
+
+    /*!
+     * \fn void processTx(UART_HandleTypeDef*)
+     * \brief TX DMA done: the sent part is free, start the next one.
+     *
+     * Call from HAL_UART_TxCpltCallback.
+     */
+    void processTx(UART_HandleTypeDef *_huart);
+
+    /*!
+     * \fn void txError()
+     * \brief TX DMA stopped by an UART error: send the part again.
+     *
+     * Call from HAL_UART_ErrorCallback when the UART is not transmitting any more
+     * (gState ready). An armed frame in flight is lost (armLost).
+     */
+    void txError();
+
+    /*!
+     * \fn bool flush(uint32_t)
+     * \brief Barrier: wait until all queued commands are sent (e.g. page switch).
+     *
+     * In interrupt it doesn't wait (TX complete can't come), it returns false.
+     * \param timeout ms
+     * \return true if the ring is empty
+     */
+    bool flush(uint32_t timeout = 150);
+
+    /*!
+     * \fn void beginBatch()
+     * \brief Commands after this are only queued, commitBatch() sends them in one DMA
+     * transfer (or two, if the ring goes round). Batches may nest.
+     */
+    void beginBatch();
+
+    /*!
+     * \fn void commitBatch()
+     * \brief End of batch, start the transfer; counters batchCmds, batchBytes are set.
+     */
+    void commitBatch();
+
+    /*!
+     * \fn void invalidate(int)
+     * \brief Forget what is shown, next setVal/setText is sent even with same value.
+     *
+     * Done here on wake up and Nextion start; call it on page change.
+     * \param page page NO, -1 all pages
      */
-    void sendCommand(const std::string &_command) const;
+    void invalidate(int page = -1);
+    void invalidateComp(uint8_t idx);
+    bool textShown(uint8_t idx) const;
+
+    // setVal/setText sent, and not sent because the value is on screen
+    uint32_t cmdSent {0};
+    uint32_t cmdSuppressed {0};
+
+    /*!
+     * \fn bool beginArm()
+     * \brief Commands up to endArm() are kept in the armed frame instead of the queue;
+     * fireArmed() sends them at once, before the queue.
+     *
+     * Values are cached as shown. A frame not fired is thrown away by the next
+     * beginArm() or by disarm().
+     * \return false if the last armed frame is still being sent (nothing is armed then)
+     */
+    bool beginArm();
+    void endArm();
+
+    /*!
+     * \fn void fireArmed()
+     * \brief Start the armed frame, from PPS interrupt. If DMA is busy, the frame goes
+     * as soon as the running part is sent.
+     */
+    void fireArmed();
+
+    // armed frame not sent: throw it away, its values are not on screen
+    void disarm();
+
+    bool isArmed() const
+        {
+        return armState == ARMED;
+        }
+
+    // time fireArmed -> TX complete, bins of LAT_BIN_US, last bin also for longer
+    static const int LAT_BINS {32};
+    static const int LAT_BIN_US {250};
+    uint32_t armLatency[LAT_BINS] {};
+    uint32_t armLatMax {0};
+
+    // commands and bytes in last committed batch
+    uint32_t batchCmds {0};
+    uint32_t batchBytes {0};
+
+    // ring full, command was lost
+    uint32_t txFull {0};
+    // armed frame not sent, DMA didn't start or stopped
+    uint32_t armLost {0};
+    // TX stopped by UART error, sent again
+    uint32_t txErrors {0};
+    // bytes of all commands sent (queued or armed), main loop may zero it
+    uint32_t txBytes {0};
+    // time [us] the caller waited in sendCommand, main loop reads and zeroes it
+    volatile uint32_t txBlockedUs {0};
+
+    /*!
+     * \fn void poll()
+     * \brief Parses data from Nextion and performs commands (touch callbacks, get
+     * answers), fails the get requests which wait longer than NEXTION_TIMEOUT.
+     *
+     * Call it in the main loop: callbacks run here, not in interrupt.
+     */
+    void poll();
+
+    // longest processRx (interrupt) in CPU cycles
+    volatile uint32_t rxIsrMax {0};
+
+    // get requests without answer in time
+    uint32_t getTimeouts {0};
+    // error answers not given to a get (a command before it may have failed)
+    uint32_t cmdErrors {0};
+
+    // frames from Nextion, bytes skipped as not part of a frame, bytes lost (ring full)
+    uint32_t rxFrames {0};
+    uint32_t rxDropped {0};
+    volatile uint32_t rxOverrun {0};
 
 private:
-    /*! Because data from Nextion reads asynchronous, it needs some signal talking that
-     * data is read
+    /*! Get requests in flight. Nextion answers in order of commands, so 0x70 / 0x71
+     * belongs to the oldest one (FIFO).
      */
-    bool dataIn {false};
+    struct Pending
+        {
+        bool text;
+        uint32_t sent;
+        // txCmds before its get command
+        uint32_t cmdsBefore;
+        NReply *reply;
+        NGetDone done;
+        void *ctx;
+        };
+    static const int MAX_PENDING {8};
+    Pending pending[MAX_PENDING];
+    volatile int pendHead {0};
+    volatile int pendNb {0};
+
+    // commands sent (queued, armed ones when they go); commands up to the last get
+    // answered (or timed out): an error is the get's only if nothing is between them
+    volatile uint32_t txCmds {0};
+    uint32_t cmdsDone {0};
+
+    bool getAsync(uint8_t idx, bool text, NReply *reply, NGetDone done, void *ctx);
+    bool popPending(Pending &p, bool timedOut);
+    void complete(bool text, bool ok, int32_t val, std::string_view txt);
+    void deliver(const Pending &p, bool ok, int32_t val, std::string_view txt);
 
 // don't change, there are Nextion's constants which we use in sending commands and
 // parsing of responses from Nextion
@@ -127,13 +285,15 @@ private:
   static const int NEX_RET_INVALID_BAUD               {0x11};
   static const int NEX_RET_INVALID_VARIABLE           {0x1A};
   static const int NEX_RET_INVALID_OPERATION          {0x1B};
+  static const int NEX_RET_ASSIGN_FAILED              {0x1C};
+  static const int NEX_RET_INVALID_PARAM_COUNT        {0x1E};
   static const int NEX_RET_EVENT_TOUCH_HEAD;
   static const int NEX_RET_EVENT_POSITION_HEAD        {0x67};
   static const int NEX_RET_CURRENT_PAGE_ID_HEAD       {0x66};
   static const int NEX_RET_EVENT_SLEEP_POSITION_HEAD  {0x68};
   static const int NEX_RET_STRING_HEAD;
   static const int NEX_RET_NUMBER_HEAD;
-  static const int NEX_RET_EVENT_LAUNCHED             {0x88};
+  static const int NEX_RET_EVENT_LAUNCHED;
   static const int NEX_RET_EVENT_WAKED;
 //    const int NEX_RET_EVENT_UPGRADED             {0x89};
 //@forma:on
@@ -146,29 +306,97 @@ private:
     const uint32_t COM_DELAY {20};
 
     char RxData[BUFF_SIZE];
-    char TxData[BUFF_SIZE];
 
-    uint32_t NextTextLen;
+    // transmit ring, every command is contiguous (the end of ring is skipped if needed),
+    // so one DMA transfer never wraps
+    static const int TX_RING {2048};
+    uint8_t txRing[TX_RING];
+    // write place, start of DMA (read place)
+    volatile int txHead {0};
+    volatile int txTail {0};
+    // end of data at the top, if head went round to 0
+    volatile int txWrap {TX_RING};
+    // bytes of running DMA, 0 = TX idle
+    volatile int txBusy {0};
+    // open batches, DMA is not started while > 0
+    volatile int txBatch {0};
+    uint32_t curCmds {0};
+    uint32_t curBytes {0};
+
+    // armed frame (see beginArm)
+    enum ArmState : uint8_t
+        {
+        ARM_IDLE, ARM_FILL, ARMED, ARM_WAIT, ARM_SENDING
+        };
+    static const int ARM_SIZE {160};
+    char armBuf[ARM_SIZE];
+    int armLen {0};
+    // commands in it, counted in txCmds when it goes (it overtakes the ring)
+    int armCmds {0};
+    volatile ArmState armState {ARM_IDLE};
+    // components in the armed frame (their cache is wrong if it isn't sent)
+    uint64_t armComps {0};
+    uint32_t armT0 {0};
+
+    uint8_t* txReserve(int n);
+    void txKick();
+    void txStart();
+    void forgetArmed();
 
-    std::string NextTxtBuff;
-    int32_t NextNumBuff;
+    uint32_t NextTextLen;
 
     UART_HandleTypeDef *p_uartHandle;
     DMA_HandleTypeDef *p_dmaHandle;
 
-    std::map<std::pair<uint8_t, uint8_t>, NObject> dObjects;
+    // components in order of addComp (declared page by page => page by page here)
+    static const int MAX_COMP {48};
+    static_assert(MAX_COMP <= 64, "armComps has 64 bits");
+    std::array<NObject, MAX_COMP> dObjects;
+    int nbObj {0};
+
+    // touch dispatch: [page][id] -> place in dObjects + 1, 0 = not registered
+    static const int MAX_PAGE {8};
+    static const int MAX_ID {64};
+    uint8_t touchIdx[MAX_PAGE][MAX_ID] {};
+
+    // last value sent per component (text as hash), same place as in dObjects
+    struct Shown
+        {
+        int32_t val;
+        uint32_t txt;
+        bool valOk {false};
+        bool txtOk {false};
+        };
+    std::array<Shown, MAX_COMP> shown {};
+
+    // handler per first byte of frame, nullptr = ignored
+    typedef void (NDisplay::*Handl)();
+    static const std::array<Handl, 256> HANDL;
+
+    // bytes from interrupt to poll(), single producer / single consumer
+    static const int RX_RING {256};
+    char rxRing[RX_RING];
+    volatile int rxHead {0};
+    volatile int rxTail {0};
+
+    // received bytes not yet parsed (frame cut by idle event)
+    static const int RX_ACC {2 * BUFF_SIZE};
+    char rxAcc[RX_ACC];
+    int rxLen {0};
+    // frame being handled, NextTextLen its length without 0xff 0xff 0xff
+    const char *rxFrame {rxAcc};
 
-    std::map<int, void (NDisplay::*)()> eventHandl;
+    bool takeFrame(char *frame);
 
     void eventTouchHandl();
     void stringHeadHandl();
     void numberHeadHandl();
     void eventWakedHandl();
+    void eventLaunchedHandl();
+    void errorHandl();
 
-    void setVal(PnO_Id key, int iOut);
-    void getVal(PnO_Id key);
-    void setText(PnO_Id key, const std::string &txtOut);
-    void getText(PnO_Id key);
+    void setVal(uint8_t idx, int iOut);
+    void setText(uint8_t idx, std::string_view txtOut);
     };
 
 #endif /* NDISPLAY_H_ */
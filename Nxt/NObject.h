@@ -19,6 +19,8 @@ public:
     NObject() :
             pNO_id( {0, 0}),
             objname(""),
+            valPre(""),
+            txtPre(""),
             callbackOnPress(nullptr),
             callbackOnRelease(nullptr)
         {
@@ -28,6 +30,8 @@ private:
     NObject(const NObject &oth) :
             pNO_id(oth.pNO_id),
             objname(oth.objname),
+            valPre(oth.valPre),
+            txtPre(oth.txtPre),
             callbackOnPress(oth.callbackOnPress),
             callbackOnRelease(oth.callbackOnRelease)
         {
@@ -37,6 +41,8 @@ private:
             void (*_callbackOnPress)(), void (*_callbackOnRelease)()) :
             pNO_id( {_page, _id}),
             objname(_objname),
+            valPre(_objname + ".val="),
+            txtPre(_objname + ".txt=\""),
             callbackOnPress(_callbackOnPress),
             callbackOnRelease(_callbackOnRelease)
 
@@ -49,6 +55,8 @@ private:
             {
             pNO_id = oth.pNO_id;
             objname = oth.objname;
+            valPre = oth.valPre;
+            txtPre = oth.txtPre;
             callbackOnPress = oth.callbackOnPress;
             callbackOnRelease = oth.callbackOnRelease;
             }
@@ -60,6 +68,9 @@ private:
     PnO_Id pNO_id;
     //Variable for storing object name
     std::string objname;
+    // command beginnings "name.val=" and "name.txt=\"", made once in addComp
+    std::string valPre;
+    std::string txtPre;
     //Function pointers for storing the callback functions
     void (*callbackOnPress)();
     void (*callbackOnRelease)();
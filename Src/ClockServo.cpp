@@ -0,0 +1,166 @@
+/*!
+ * \file ClockServo.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <cmath>
+#include "ClockServo.h"
+
+ClockServo::ClockServo(double f0, Mode m) :
+        mode(m), f(f0), u(f0), f_avg(f0), f_mark(f0)
+    {
+    setPI(10);
+    // PPS +-50 ns ~ 5 ticks, timer 1 tick, crystal walk, phase out in 5 s
+    setKalman(1, 0.01, 25, 5);
+    restart();
+    // crystal +-100 ppm
+    p11 = 1e8;
+    }
+
+void ClockServo::setPI(double _tau, double zeta)
+    {
+    kp = 2 * zeta / _tau;
+    ki = 1 / (_tau * _tau);
+    }
+
+void ClockServo::setKalman(double q_x, double q_f, double _r, double _tau)
+    {
+    qx = q_x;
+    qf = q_f;
+    r = _r;
+    tau = _tau;
+    }
+
+void ClockServo::tune(double _r, double q_f)
+    {
+    r = _r;
+    qf = q_f;
+    // measured white phase has the timer rounding in it, no phase walk is left
+    qx = 0;
+    // the filter is matched to the noises, its phase is the best guess: steered out in
+    // one second (the loop time constant is the filter's, loop_tau)
+    tau = 1;
+    setPI(loop_tau());
+    }
+
+void ClockServo::restart()
+    {
+    x = 0;
+    p00 = r;
+    p01 = 0;
+    }
+
+// ARR is integer: rounding error goes to the next second (mean of ARR is u),
+// model goes on with what timer really counts
+int ClockServo::output()
+    {
+    double want = u + sd;
+    int arr = (int) std::lround(want);
+    sd = dither ? want - arr : 0;
+    u = arr;
+
+    return arr;
+    }
+
+// locked: long time frequency and its change
+void ClockServo::learn()
+    {
+    if (nhold > 0)
+        {
+        // frequency after holdover is not settled
+        nhold = 0;
+        win = -F_AVG_T;
+        }
+
+    if (win < -F_AVG_T / 2)
+        {
+        // loop is locking, average starts later
+        f_avg = f;
+        }
+    else
+        {
+        f_known = true;
+        // aging added, no lag of the ramp
+        f_avg += (f - f_avg) / F_AVG_T + aging;
+        }
+
+    if (++win == 0)
+        {
+        f_mark = f_avg;
+        }
+    else if (win == AGING_WIN)
+        {
+        // random walk of frequency looks like aging too: spread of the windows
+        double a = (f_avg - f_mark) / AGING_WIN;
+        aging_var += ((a - aging) * (a - aging) - aging_var) / AGING_AVG;
+        aging += (a - aging) / AGING_AVG;
+        f_mark = f_avg;
+        win = 0;
+        }
+    }
+
+int ClockServo::hold()
+    {
+    if (nhold++ == 0)
+        {
+        // long time average, less noise
+        f = f_avg;
+        }
+
+    // one second by model
+    x += f - u;
+    f += aging;
+    p00 += 2 * p01 + p11 + qx;
+    p01 += p11;
+    p11 += qf;
+
+    u = mode == PI ? f : f + steer(x / tau);
+
+    return output();
+    }
+
+int ClockServo::update(int z)
+    {
+    if (mode == PI)
+        {
+        x = z;
+        // no wind up of the integral while the phase is slewed out (with this step
+        // the output would be over the limit)
+        if (!saturated((kp + ki) * x))
+            {
+            f += ki * x;
+            }
+        u = f + steer(kp * x);
+        learn();
+
+        return output();
+        }
+
+    // predict
+    double xp = x + f - u;
+    f += aging;
+    double a00 = p00 + 2 * p01 + p11 + qx;
+    double a01 = p01 + p11;
+    double a11 = p11 + qf;
+
+    // correct
+    double s = a00 + r;
+    double k0 = a00 / s;
+    double k1 = a01 / s;
+    double in = z - xp;
+
+    x = xp + k0 * in;
+    if (!saturated(x / tau))
+        {
+        f += k1 * in;
+        }
+    p00 = (1 - k0) * a00;
+    p01 = (1 - k0) * a01;
+    p11 = a11 - k1 * a01;
+
+    u = f + steer(x / tau);
+    learn();
+
+    return output();
+    }
@@ -9,16 +9,18 @@
 #include "GPS.h"
 #include "GPSsat.h"
 
-static int totNbMsg_exp = 0;
-static int currNbMsg_exp = 0;
 
 // commands to setup gps unit:
 const char GPS::SET_NMEA_BAUDRATE[] = "$PMTK251,115200*1F\r\n";
 const char GPS::SET_NMEA_UPDATERATE[] = "$PMTK220,250*29\r\n"; //
-const char GPS::API_SET_OUTPUT[] = "$PMTK314,0,1,0,0,0,1,0,0,0,0,0,0,0,0,0,0,0,0,0*28\r\n";
+// RMC, GGA, GSA and GSV every fix
+const char GPS::API_SET_OUTPUT[] = "$PMTK314,0,1,0,1,1,1,0,0,0,0,0,0,0,0,0,0,0,0,0*28\r\n";
 
-const std::string GPS::GSV {"$GPGSV"};
-const std::string GPS::RMC {"$GPRMC"};
+// indexed by nmea::Type
+const GPS::Handler GPS::handlers[nmea::TYPE_NB] {GPS::parse_rmc, GPS::parse_gsv,
+        GPS::parse_gga, GPS::parse_gsa};
+GPS::GsvBurst GPS::gsv[gnss::SYS_NB];
+bool GPS::gsa_done[gnss::SYS_NB];
 
 int GPS::gps_second;
 int GPS::gps_minute;
@@ -28,10 +30,22 @@ int GPS::gps_month;
 int GPS::gps_day;
 int GPS::gps_sattNumb {0};
 
+bool GPS::rmc_valid {false};
+int GPS::fix_quality {-1};
+int GPS::sats_used {-1};
+int GPS::fix_mode {-1};
+int GPS::hdop {-1};
+int GPS::pdop {-1};
+int GPS::vdop {-1};
+uint64_t GPS::used[gnss::SYS_NB];
+
 int GPS::sentenceID;
 uint8_t GPS::acquired {0};
 uint8_t GPS::gps_rx[RXSZ];
 
+NmeaStream GPS::stream(GPS::on_sentence);
+volatile bool GPS::epoch_open {false};
+
 void GPS::unset()
     {
     gps_second = -1;
@@ -41,6 +55,17 @@ void GPS::unset()
     gps_month = -1;
     gps_day = -1;
     gps_sattNumb = 0;
+
+    rmc_valid = false;
+    fix_quality = -1;
+    sats_used = -1;
+    fix_mode = -1;
+    hdop = pdop = vdop = -1;
+    for (int i = 0; i < gnss::SYS_NB; ++i)
+        {
+        used[i] = 0;
+        gsa_done[i] = false;
+        }
     }
 
 bool GPS::set_time(const std::string_view &t)
@@ -59,19 +84,17 @@ bool GPS::set_time(const std::string_view &t)
     return true;
     }
 
+// the sky list is sorted once, its head is the ranking of the bars
 void GPS::update_strong()
     {
-    SVs::strongest_sats.clear();
+    SVs::sort_z();
 
-    for (auto const& [key, val] : SVs::new_spaceVehicles)
+    SVs::strongest_sats.clear();
+    for (int i = 0; i < SVs::z_nb && i < SVs::NB_STRONG; ++i)
         {
-        SVs::strongest_sats.push_back( {key, val.SNR});
+        const GPSsat &s = SVs::new_spaceVehicles[SVs::z_order[i]];
+        SVs::strongest_sats.update( {s.key(), s.id, s.SNR});
         }
-
-    // strongest satellite first
-    std::sort(std::begin(SVs::strongest_sats), std::end(SVs::strongest_sats),
-            [](Strong a, Strong b)
-                {return a.snr > b.snr;});
     }
 
 bool GPS::set_date(const std::string_view &d)
@@ -88,15 +111,37 @@ bool GPS::set_date(const std::string_view &d)
     return true;
     }
 
-void GPS::read_data()
+void GPS::begin_epoch()
     {
-    totNbMsg_exp = 0;
-    currNbMsg_exp = 0;
+// the UART4 callback decodes, do not let it see half cleared data
+    __disable_irq();
+    for (auto &b : gsv)
+        {
+        b = GsvBurst();
+        }
     SVs::new_spaceVehicles.clear();
+    SVs::strongest_sats.clear();
     acquired = 0;
     unset();
+    epoch_open = true;
+    __enable_irq();
+    }
 
-    parse_sentences();
+void GPS::on_sentence(const NmeaFields &fields)
+    {
+    if (epoch_open)
+        {
+        parse_sentence(fields);
+        }
+    }
+
+/*!
+ * data are already decoded by the stream (see begin_epoch), here we close the
+ * second and finish
+ */
+void GPS::read_data()
+    {
+    epoch_open = false;
 
     if ((acquired & GSV_FLS) == GSV_FLS)
         {
@@ -104,45 +149,86 @@ void GPS::read_data()
         }
     }
 
-void GPS::parse_sentences()
+bool GPS::parse_sentence(const NmeaFields &fields)
     {
-// can be more sentences in one packet, split and then split again
-    auto split_values = split((char*) gps_rx, "\r\n");
-
-    for (unsigned int i = 0; i < split_values.size(); ++i)
+    const nmea::Tag *tag = nmea::find_tag(fields[0]);
+    if (tag == nullptr)
         {
-        if (!cntrCheckSum(split_values[i]))
-            {
-            continue;
-            }
-
-        auto fields = split(split_values[i], ",");
-        if (!parse_sentence(fields)) continue;
+        return false;
         }
+
+    sentenceID = tag->type;
+    return handlers[tag->type](fields, tag->sys);
     }
 
-bool GPS::check_what_sentence(const std::string_view &field)
+//1      2      3 4         5 6          7 8  9  0      1   2 3
+//$GPRMC,001225,A,2832.1834,N,08101.0536,W,12,25,251211,1.2,E,A*03
+bool GPS::parse_rmc(const NmeaFields &fields, gnss::Sys)
     {
-    sentenceID = 0;
+    if ((acquired & RCM_FLTD) == RCM_FLTD)
+        {
+        return true; // already in-read
+        }
 
-    if (field == RMC)
+    if (fields.size() < 10)
         {
-        sentenceID = RMC_ID;
-        return true;
+        return false;
         }
 
-    if (field == GSV)
+    // A valid, V void
+    rmc_valid = fields[2] == "A";
+
+    if (fields[1].empty() || !set_time(fields[1]))
         {
-        sentenceID = GSV_ID;
-        return true;
+        acquired &= ~RCM_FLTD;
+        return false;
+        }
+
+    if (fields[9].empty() || !set_date(fields[9]))
+        {
+        acquired &= ~RCM_FLTD;
+        return false;
         }
 
-    return false;
+    acquired |= RCM_FLTD;
+    return true;
     }
 
-bool GPS::parse_sentence(const std::vector<std::string_view> &fields)
+// satellite data are read when every system which started a GSV burst has finished it
+void GPS::check_gsv_done()
     {
+    bool any = false;
+    int nb = 0;
+
+    for (const auto &b : gsv)
+        {
+        if (b.tot == 0)
+            {
+            continue;
+            }
+
+        if (!b.done)
+            {
+            return;
+            }
 
+        any = true;
+        nb += b.inView;
+        }
+
+    if (any)
+        {
+        gps_sattNumb = nb;
+        acquired |= GSV_FLS;
+        }
+    }
+
+//id{Satellite ID}, E{elevation}, Az{Azimuth}, S{SNR}
+//0      1 2 3  4  5  6   7  8  9  0   1  2  3  4   5  6  7  18 19
+//              id E  Az  S  id E  Az  S  id E  Az  S  id E  Az  S
+//$GPGSV,3,1,11,10,68,137,19,27,65,176,28,08,63,271,33,23,45,063,29*72
+bool GPS::parse_gsv(const NmeaFields &fields, gnss::Sys sys)
+    {
     static int id_pos = 4;   // then +4
     unsigned int elev_pos = 5;   // ..
     unsigned int azim_pos = 6;
@@ -152,138 +238,194 @@ bool GPS::parse_sentence(const std::vector<std::string_view> &fields)
     int currMsgNb_find;
     GPSsat gpsSV;
     int v;
-    std::vector<std::string_view> last;
 
-    if (check_what_sentence(fields[0]))
+    // each system has own burst
+    GsvBurst &b = gsv[sys];
+
+    if (b.done)
+        {
+        return true; // satellites of the system already in-read
+        }
+
+    if (fields.size() < 4)
+        {
+        return false;
+        }
+
+    // sat. info takes up to 3 messages (GPS), more if many systems
+    totNbMsg_find = get_nd(fields[1], 0, fields[1].size());
+    if (totNbMsg_find < 1)
+        {
+        return false;
+        }
+
+    currMsgNb_find = get_nd(fields[2], 0, fields[2].size());
+    if (currMsgNb_find < 1)
+        {
+        return false;
+        }
+
+    if (currMsgNb_find == 1)
+        {
+        b = GsvBurst();
+        b.tot = totNbMsg_find;
+        }
+    // message not in sequence
+    else if (b.tot != totNbMsg_find || currMsgNb_find != b.cur + 1)
+        {
+        return false;
+        }
+
+    b.cur = currMsgNb_find;
+
+    // 0 in view (e.g. GL/GA/BD before sky fix): "$GLGSV,1,1,00", no satellite fields
+    b.inView = get_nd(fields[3], 0, fields[3].size());
+    if (b.inView < 0)
         {
+        return false;
+        }
 
-        switch (sentenceID)
+    // checksum is not a field, so last SNR is read as the others
+    for (int i = 0; (int) srn_pos + i < fields.size(); i += 4)
+        {
+        // BeiDou and Galileo can come as 201.., 301..
+        if (!read_check(fields[id_pos + i], 1, 499, v))
             {
-        //1      2      3 4         5 6          7 8  9  0      1   2 3
-        //$GPRMC,001225,A,2832.1834,N,08101.0536,W,12,25,251211,1.2,E,A*03
-        case RMC_ID:
-            if ((acquired & RCM_FLTD) == RCM_FLTD)
-                {
-                return true; // already in-read
-                }
-
-            if (fields[1].empty() || !set_time(fields[1]))
-                {
-                acquired &= ~RCM_FLTD;
-                return false;
-                }
-
-            if (fields[9].empty() || !set_date(fields[9]))
-                {
-                acquired &= ~RCM_FLTD;
-                return false;
-                }
-
-            acquired |= RCM_FLTD;
-            break;
-
-            //id{Satellite ID}, E{elevation}, Az{Azimuth}, S{SNR}
-//          0      1 2 3  4  5  6   7  8  9  0   1  2  3  4   5  6  7  18 19
-//                        id E  Az  S  id E  Az  S  id E  Az  S  id E  Az  S
-//          $GPGSV,3,1,11,10,68,137,19,27,65,176,28,08,63,271,33,23,45,063,29*72
-
-        case GSV_ID:
-            ++currNbMsg_exp;
-
-            if ((acquired & GSV_FLS) == GSV_FLS)
-                {
-                return true; // satellite nb. already in-read
-                }
-            // sat. info can take up to 3 messages
-            totNbMsg_find = get_nd(fields[1], 0, fields[1].size());
-            if (totNbMsg_find < 1)
-                {
-                return false;
-                }
-            if (currNbMsg_exp == 1)
-                {
-                totNbMsg_exp = totNbMsg_find;
-                }
-
-            currMsgNb_find = get_nd(fields[2], 0, fields[2].size());
-            if (currMsgNb_find < 1)
-                {
-                return false;
-                }
-
-            // message not in sequence
-            if (totNbMsg_exp != totNbMsg_find || currMsgNb_find != currNbMsg_exp)
-                {
-                return false;
-                }
-
-            gps_sattNumb = get_nd(fields[3], 0, fields[3].size());
-            if (gps_sattNumb < 1)
-                {
-                return false;
-                }
-
-            for (std::vector<std::basic_string_view<char>>::size_type i = 0;
-                    i < (fields.size() - 4); i += 4)
-                {
-                if (!read_check(fields[id_pos + i], 1, 79, v))
-                    {
-                    return false;
-                    }
-
-                gpsSV.id = v;
-
-                if (!read_check(fields[elev_pos + i], 0, 90, v))
-                    {
-                    return false;
-                    }
-
-                gpsSV.elevation = v;
-
-                if (!read_check(fields[azim_pos + i], 0, 359, v))
-                    {
-                    return false;
-                    }
-
-                gpsSV.azimuth = v;
-
-                // last field, special, there is a * and check sum in the field
-                if (srn_pos + i == fields.size() - 1)
-                    {
-                    last = split(fields[srn_pos + i], "*");
-
-                    if (!read_check(last[0], 0, 99, v))
-                        {
-                        return false;
-                        }
-
-                    gpsSV.SNR = v;
-                    }
-                else
-                    {
-                    if (!read_check(fields[srn_pos + i], 0, 99, v))
-                        {
-                        return false;
-                        }
-                    gpsSV.SNR = v;
-                    }
-
-                // if we are here one sat. is in-read
-                GPSsat sat(gpsSV);
-                SVs::new_spaceVehicles.insert( {sat.id, sat});
-                if (SVs::new_spaceVehicles.size() == (uint32_t) gps_sattNumb)
-                    {
-                    acquired |= GSV_FLS;
-                    }
-                } //for (std::vector
-
-            return true;
-
-        default:
             return false;
             }
-        } //if (check_what_sentence(fields[0]))
 
-    return false;
+        gnss::Sys s = sys;
+        int prn = gnss::norm_prn(s, v);
+
+        if (!read_check(fields[elev_pos + i], 0, 90, v))
+            {
+            return false;
+            }
+
+        gpsSV.elevation = v;
+
+        if (!read_check(fields[azim_pos + i], 0, 359, v))
+            {
+            return false;
+            }
+
+        gpsSV.azimuth = v;
+
+        if (!read_check(fields[srn_pos + i], 0, 99, v))
+            {
+            return false;
+            }
+        gpsSV.SNR = v;
+
+        // unknown numbering (e.g. QZSS), can't be placed
+        if (prn == 0)
+            {
+            continue;
+            }
+
+        gpsSV.id = prn;
+        gpsSV.sys = s;
+
+        // if we are here one sat. is in-read
+        GPSsat sat(gpsSV);
+        SVs::new_spaceVehicles.insert(sat.key(), sat);
+        } //for (int i
+
+    if (b.cur == b.tot)
+        {
+        b.done = true;
+        check_gsv_done();
+        }
+
+    return true;
     }
 
+//0      1          2         3 4          5 6 7  8   9    0 1    2 3 4
+//$GPGGA,064951.000,2307.1256,N,12016.4438,E,1,08,0.95,39.9,M,17.8,M,,*65
+bool GPS::parse_gga(const NmeaFields &fields, gnss::Sys)
+    {
+    if ((acquired & GGA_FL) == GGA_FL)
+        {
+        return true; // already in-read
+        }
+
+    if (fields.size() < 9)
+        {
+        return false;
+        }
+
+    int q = get_nd(fields[6], 0, fields[6].size());
+    int n = get_nd(fields[7], 0, fields[7].size());
+    int h = get_fix(fields[8], 2);
+    if (q < 0 || n < 0 || h < 0)
+        {
+        return false;
+        }
+
+    fix_quality = q;
+    sats_used = n;
+    // "0" was an empty field
+    hdop = h > 0 ? h : -1;
+
+    acquired |= GGA_FL;
+    return true;
+    }
+
+//0      1 2 3  4  5  6  7  8  9  0  1  2  3  4 5    6    7    8
+//$GPGSA,A,3,29,21,26,15,18,09,06,10,,,,,2.32,0.95,2.11*00
+//                                              PDOP HDOP VDOP (system ID, NMEA 4.1)
+bool GPS::parse_gsa(const NmeaFields &fields, gnss::Sys sys)
+    {
+    static const int PRN_POS {3};
+    static const int PRN_MAX {12};
+
+    if (fields.size() < PRN_POS + PRN_MAX + 3)
+        {
+        return false;
+        }
+
+    // combined (GN) GSA tells its system, 1 GPS, 2 GLONASS, 3 Galileo, 4 BeiDou
+    if (fields.size() > PRN_POS + PRN_MAX + 3)
+        {
+        int id = get_nd(fields[PRN_POS + PRN_MAX + 3], 0, 1);
+        if (id > 0 && id <= gnss::SYS_NB)
+            {
+            sys = (gnss::Sys) (id - 1);
+            }
+        }
+
+    if (gsa_done[sys])
+        {
+        return true; // already in-read
+        }
+
+    int mode = get_nd(fields[2], 0, fields[2].size());
+    int p = get_fix(fields[PRN_POS + PRN_MAX], 2);
+    int h = get_fix(fields[PRN_POS + PRN_MAX + 1], 2);
+    int v = get_fix(fields[PRN_POS + PRN_MAX + 2], 2);
+    if (mode < 1 || p < 0 || h < 0 || v < 0)
+        {
+        return false;
+        }
+
+    for (int i = PRN_POS; i < PRN_POS + PRN_MAX; ++i)
+        {
+        int prn = get_nd(fields[i], 0, fields[i].size());
+        gnss::Sys s = sys;
+        prn = prn > 0 ? gnss::norm_prn(s, prn) : 0;
+        if (prn > 0)
+            {
+            used[s] |= (uint64_t) 1 << (prn - 1);
+            }
+        }
+
+    // DOP is for the whole solution, same in all GSA of one fix
+    fix_mode = mode;
+    pdop = p > 0 ? p : -1;
+    hdop = h > 0 ? h : hdop;
+    vdop = v > 0 ? v : -1;
+
+    gsa_done[sys] = true;
+    acquired |= GSA_FL;
+    return true;
+    }
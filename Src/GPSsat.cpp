@@ -3,11 +3,12 @@
 
 #include "GPSsat.h"
 
-std::map<int, GPSsat> SVs::new_spaceVehicles;
-std::map<int, GPSsat> SVs::old_spaceVehicles;
-std::vector<Strong> SVs::strongest_sats;
+SVs::SatSet SVs::new_spaceVehicles;
+SVs::SatSet SVs::old_spaceVehicles;
+SatRank<SVs::NB_STRONG> SVs::strongest_sats;
+int SVs::z_order[gnss::SAT_NB];
+int SVs::z_nb {0};
 
 const char *SVs::COLORS[4] = {"WHITE", "YELLOW", "48545", "40137"};
 
 int SVs::indx {0};
-char SVs::buf[64];
@@ -62,3 +62,39 @@ int get_nd(const std::string_view &field, int pos, int n)
 
     return r;
     }
+
+/*!
+ * decimal number to fixed point, "1.25" with 2 decimals => 125, more decimals in the
+ * field are cut, -1 if not a number
+ */
+int get_fix(const std::string_view &field, int decimals)
+    {
+    auto dot = field.find('.');
+    int r = get_nd(field, 0, dot == std::string_view::npos ? field.size() : dot);
+    if (r == -1)
+        {
+        return -1;
+        }
+
+    std::string_view frac;
+    if (dot != std::string_view::npos)
+        {
+        frac = field.substr(dot + 1);
+        }
+
+    for (int i = 0; i < decimals; ++i)
+        {
+        r *= 10;
+        if (i < (int) frac.size())
+            {
+            int d = frac[i] - '0';
+            if (d < 0 || d > 9)
+                {
+                return -1;
+                }
+            r += d;
+            }
+        }
+
+    return r;
+    }
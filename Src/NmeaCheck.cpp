@@ -0,0 +1,122 @@
+/*!
+ * \file NmeaCheck.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <cstring>
+#include "NmeaCheck.h"
+
+namespace
+{
+const uint32_t ONES {0x01010101};
+const uint32_t HIGHS {0x80808080};
+const uint32_t STARS {ONES * '*'};
+const uint32_t DOLLARS {ONES * '$'};
+
+// true if one of the bytes in w is zero
+inline bool has_zero(uint32_t w)
+    {
+    return ((w - ONES) & ~w & HIGHS) != 0;
+    }
+
+inline uint32_t load(const char *p)
+    {
+    uint32_t w;
+    std::memcpy(&w, p, sizeof(w));
+    return w;
+    }
+}
+
+int nmea::xor_sum(std::string_view s, std::string_view::size_type &star)
+    {
+    const std::string_view::size_type n = s.size();
+    std::string_view::size_type i = 1;
+    uint32_t acc = 0;
+
+    // whole words as long as they have no '*' and no '$'
+    while (i + sizeof(uint32_t) <= n)
+        {
+        uint32_t w = load(s.data() + i);
+        if (has_zero(w ^ STARS) || has_zero(w ^ DOLLARS))
+            {
+            break;
+            }
+        acc ^= w;
+        i += sizeof(uint32_t);
+        }
+
+    acc ^= acc >> 16;
+    acc ^= acc >> 8;
+    int sum = acc & 0xff;
+
+    for (; i < n; ++i)
+        {
+        char c = s[i];
+        if (c == '*')
+            {
+            star = i;
+            return sum;
+            }
+
+        if (c == '$')
+            {
+            // pair $ and * don't match
+            return -1;
+            }
+
+        sum ^= (uint8_t) c;
+        }
+
+    return -1;
+    }
+
+bool nmea::check(std::string_view s)
+    {
+    auto st = s.find('$');
+    if (st == std::string_view::npos)
+        {
+        return false;
+        }
+    s.remove_prefix(st);
+
+    std::string_view::size_type star;
+    int sum = xor_sum(s, star);
+    if (sum < 0 || s.size() < star + 3)
+        {
+        return false;
+        }
+
+    return sum == hex2(s[star + 1], s[star + 2]);
+    }
+
+int nmea::scan(std::string_view packet, Span *out, int max)
+    {
+    int nb = 0;
+    std::string_view::size_type pos = 0;
+
+    while (nb < max && (pos = packet.find('$', pos)) != std::string_view::npos)
+        {
+        std::string_view s = packet.substr(pos);
+        std::string_view::size_type star;
+        int sum = xor_sum(s, star);
+
+        if (sum < 0)
+            {
+            // a second '$' before '*', start again from it
+            ++pos;
+            continue;
+            }
+
+        if (s.size() >= star + 3 && sum == hex2(s[star + 1], s[star + 2]))
+            {
+            out[nb].off = pos;
+            out[nb].len = star + 3;
+            ++nb;
+            }
+
+        pos += star + 1;
+        }
+
+    return nb;
+    }
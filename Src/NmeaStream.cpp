@@ -0,0 +1,141 @@
+/*!
+ * \file NmeaStream.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "NmeaCheck.h"
+#include "NmeaStream.h"
+
+void NmeaStream::feed(const uint8_t *data, int size)
+    {
+    for (int i = 0; i < size; ++i)
+        {
+        uint8_t c = data[i];
+
+        // '$' always starts new sentence, even if the last one is broken
+        if (c == '$')
+            {
+            if (state != HUNT && state != END)
+                {
+                ++errors;
+                }
+            start();
+            continue;
+            }
+
+        int d;
+
+        switch (state)
+            {
+        case HUNT:
+            break;
+
+        case BODY:
+            if (c == '*')
+                {
+                if (!addField())
+                    {
+                    fail();
+                    break;
+                    }
+                state = CS_HI;
+                break;
+                }
+
+            if (c == '\r' || c == '\n' || len == MAX_LEN)
+                {
+                // sentence without checksum is not accepted
+                fail();
+                break;
+                }
+
+            line[len] = c;
+            sum ^= c;
+            if (c == ',' && !addField())
+                {
+                fail();
+                break;
+                }
+            ++len;
+            break;
+
+        case CS_HI:
+            d = nmea::HEX[c];
+            if (d < 0)
+                {
+                fail();
+                break;
+                }
+            ctr = d << 4;
+            state = CS_LO;
+            break;
+
+        case CS_LO:
+            d = nmea::HEX[c];
+            if (d < 0)
+                {
+                fail();
+                break;
+                }
+            ctr |= d;
+            state = END;
+            break;
+
+        case END:
+            if (c == '\r')
+                {
+                break;
+                }
+
+            if (c == '\n')
+                {
+                done();
+                }
+            else
+                {
+                fail();
+                }
+            break;
+            }
+        }
+    }
+
+void NmeaStream::start()
+    {
+    line[0] = '$';
+    len = 1;
+    fst = 0;
+    sum = 0;
+    fields.clear();
+    state = BODY;
+    }
+
+// the field from fst up to (not incl.) len
+bool NmeaStream::addField()
+    {
+    bool ok = fields.push(std::string_view(line + fst, len - fst));
+    fst = len + 1;
+
+    return ok;
+    }
+
+void NmeaStream::fail()
+    {
+    ++errors;
+    state = HUNT;
+    }
+
+void NmeaStream::done()
+    {
+    state = HUNT;
+
+    if (sum != ctr)
+        {
+        ++errors;
+        return;
+        }
+
+    ++sentences;
+    handler(fields);
+    }
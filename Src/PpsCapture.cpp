@@ -0,0 +1,93 @@
+/*!
+ * \file PpsCapture.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <cstdio>
+#include "main.h"
+#include "tim.h"
+#include "PpsCapture.h"
+
+uint32_t ppscap::hist[HIST_NB];
+volatile int ppscap::missing {MISSING_MAX};
+
+// both time stamps of this second
+static uint32_t cap_cnt;
+static uint32_t exti_cnt;
+static bool cap_in;
+static bool exti_in;
+
+void ppscap::init()
+    {
+    __HAL_RCC_GPIOA_CLK_ENABLE();
+
+    GPIO_InitTypeDef gpio {};
+    gpio.Pin = GPIO_PIN_15;
+    gpio.Mode = GPIO_MODE_AF_PP;
+    gpio.Pull = GPIO_NOPULL;
+    gpio.Speed = GPIO_SPEED_FREQ_LOW;
+    gpio.Alternate = GPIO_AF1_TIM2;
+    HAL_GPIO_Init(GPIOA, &gpio);
+
+    TIM_IC_InitTypeDef ic {};
+    ic.ICPolarity = TIM_INPUTCHANNELPOLARITY_RISING;
+    ic.ICSelection = TIM_ICSELECTION_DIRECTTI;
+    ic.ICPrescaler = TIM_ICPSC_DIV1;
+    ic.ICFilter = 0;
+    if (HAL_TIM_IC_ConfigChannel(&htim2, &ic, TIM_CHANNEL_1) != HAL_OK)
+        {
+        Error_Handler();
+        }
+
+    HAL_TIM_IC_Start_IT(&htim2, TIM_CHANNEL_1);
+    }
+
+void ppscap::tick()
+    {
+    if (missing < MISSING_MAX)
+        {
+        missing = missing + 1;
+        }
+    cap_in = exti_in = false;
+    }
+
+// second one of the pair makes the entry
+static void pair()
+    {
+    if (!cap_in || !exti_in)
+        {
+        return;
+        }
+
+    uint32_t d = exti_cnt - cap_cnt;
+    ++ppscap::hist[d < ppscap::HIST_NB ? d : ppscap::HIST_NB - 1];
+    }
+
+void ppscap::from_capture(uint32_t cnt)
+    {
+    missing = 0;
+    cap_cnt = cnt;
+    cap_in = true;
+    pair();
+    }
+
+void ppscap::from_exti(uint32_t cnt)
+    {
+    exti_cnt = cnt;
+    exti_in = true;
+    pair();
+    }
+
+void ppscap::print_hist()
+    {
+    std::printf("exti-capture [ticks]:");
+    for (int i = 0; i < HIST_NB; ++i)
+        {
+        if (hist[i] != 0)
+            {
+            std::printf(" %d:%lu", i, hist[i]);
+            }
+        }
+    std::printf("\r\n");
+    }
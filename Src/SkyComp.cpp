@@ -0,0 +1,180 @@
+/*!
+ * \file SkyComp.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <algorithm>
+#include "GPSsat.h"
+#include "SkyComp.h"
+
+uint32_t SkyComp::frame_bytes {0};
+uint32_t SkyComp::total_bytes {0};
+uint32_t SkyComp::frame_cmds {0};
+Rect SkyComp::erases[MAX_RECT];
+int SkyComp::nb_erase {0};
+
+Rect Rect::bbox(const Rect &o) const
+    {
+    Rect r;
+    r.x = std::min(x, o.x);
+    r.y = std::min(y, o.y);
+    r.w = std::max(x + w, o.x + o.w) - r.x;
+    r.h = std::max(y + h, o.y + o.h) - r.y;
+
+    return r;
+    }
+
+Rect SkyComp::rect_of(const GPSsat &s)
+    {
+    return {s.xo + SVs::DCLR, s.yo + SVs::DCLR, SVs::WCLR, SVs::WCLR};
+    }
+
+void SkyComp::send(std::string_view cmd)
+    {
+    display.sendCommand(cmd);
+
+    // + 3 x 0xff
+    uint32_t n = cmd.size() + 3;
+    frame_bytes += n;
+    total_bytes += n;
+    ++frame_cmds;
+    }
+
+void SkyComp::add_erase(const Rect &r)
+    {
+    if (nb_erase == MAX_RECT)
+        {
+        // never seen, but don't lose the area
+        erases[MAX_RECT - 1] = erases[MAX_RECT - 1].bbox(r);
+        return;
+        }
+
+    erases[nb_erase++] = r;
+    }
+
+// overlapping rectangles in one, if the box is not bigger than the two
+void SkyComp::merge()
+    {
+    bool again = true;
+
+    while (again)
+        {
+        again = false;
+
+        for (int i = 0; i < nb_erase && !again; ++i)
+            {
+            for (int j = i + 1; j < nb_erase; ++j)
+                {
+                if (!erases[i].intersects(erases[j]))
+                    {
+                    continue;
+                    }
+
+                Rect b = erases[i].bbox(erases[j]);
+                if (b.area() > erases[i].area() + erases[j].area())
+                    {
+                    continue;
+                    }
+
+                erases[i] = b;
+                erases[j] = erases[--nb_erase];
+                again = true;
+                break;
+                }
+            }
+        }
+    }
+
+bool SkyComp::damaged(const Rect &r)
+    {
+    for (int i = 0; i < nb_erase; ++i)
+        {
+        if (erases[i].intersects(r))
+            {
+            return true;
+            }
+        }
+
+    return false;
+    }
+
+void SkyComp::compose()
+    {
+    auto &olds = SVs::old_spaceVehicles;
+    auto &news = SVs::new_spaceVehicles;
+
+    frame_bytes = 0;
+    frame_cmds = 0;
+    nb_erase = 0;
+
+    // vanished satellites and moved ones (old position) are erased
+    for (int k : olds)
+        {
+        if (!news.contains(k))
+            {
+            olds[k].flag = GPSsat::E;
+            }
+
+        if (olds[k].has2clear())
+            {
+            add_erase(rect_of(olds[k]));
+            }
+        }
+
+    merge();
+
+    // touched by an erase => repaint
+    if (nb_erase > 0)
+        {
+        for (int k : news)
+            {
+            if (damaged(rect_of(news[k])))
+                {
+                olds[k].flag |= GPSsat::P;
+                }
+            }
+        }
+
+    // display order [strongest on top]: from the weakest, a repainted satellite makes
+    // stronger neighbours repainted
+    for (int i = SVs::z_nb - 1; i >= 0; --i)
+        {
+        int k = SVs::z_order[i];
+        if (olds[k].has2paint())
+            {
+            SVs::near_stronger(i, [&olds](int n)
+                {
+                olds[n].flag |= GPSsat::P;
+                });
+            }
+        }
+
+    for (int i = 0; i < nb_erase; ++i)
+        {
+        const Rect &r = erases[i];
+        NCmd cmd;
+        cmd.str("picq ").nums(r.x, r.y, r.w, r.h).chr('0');
+        send(cmd.view());
+        }
+
+    for (int k : olds)
+        {
+        if (!news.contains(k))
+            {
+            olds.erase(k);
+            }
+        }
+
+    // every symbol once, weakest first
+    for (int i = SVs::z_nb - 1; i >= 0; --i)
+        {
+        int k = SVs::z_order[i];
+        if (olds[k].has2paint())
+            {
+            SVs::draw_sat(news[k]);
+            }
+
+        olds[k] = news[k];
+        }
+    }
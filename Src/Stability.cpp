@@ -0,0 +1,107 @@
+/*!
+ * \file Stability.cpp
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <cstdio>
+#include "Stability.h"
+
+void Stability::add(double x)
+    {
+    // block average of level 0 is the phase
+    double a = x;
+
+    for (int k = 0; k < LEVELS; ++k)
+        {
+        Level &l = lev[k];
+
+        if (l.filled == 2)
+            {
+            double d = x - 2 * l.x1 + l.x0;
+            double m = a - 2 * l.a1 + l.a0;
+            l.sa += d * d;
+            l.sm += m * m;
+            ++l.n;
+            }
+        else
+            {
+            ++l.filled;
+            }
+        l.x0 = l.x1;
+        l.x1 = x;
+        l.a0 = l.a1;
+        l.a1 = a;
+
+        if (!l.half)
+            {
+            l.xh = x;
+            l.ah = a;
+            l.half = true;
+            return;
+            }
+
+        // block of the next level: first phase, mean of both averages
+        l.half = false;
+        x = l.xh;
+        a = (l.ah + a) / 2;
+        }
+    }
+
+void Stability::gap()
+    {
+    for (Level &l : lev)
+        {
+        l.filled = 0;
+        l.half = false;
+        }
+    }
+
+void Stability::clear()
+    {
+    lev = {};
+    }
+
+double Stability::avar(int k) const
+    {
+    const Level &l = lev[k];
+    double t = tau(k);
+    return l.n == 0 ? 0 : l.sa / (2 * t * t * l.n);
+    }
+
+double Stability::mvar(int k) const
+    {
+    const Level &l = lev[k];
+    double t = tau(k);
+    return l.n == 0 ? 0 : l.sm / (2 * t * t * l.n);
+    }
+
+int Stability::best_level() const
+    {
+    int best = -1;
+
+    for (int k = 0; k < LEVELS; ++k)
+        {
+        if (lev[k].n >= MIN_N && (best < 0 || avar(k) < avar(best)))
+            {
+            best = k;
+            }
+        }
+
+    return best;
+    }
+
+void Stability::print() const
+    {
+    std::printf("tau [s]  n  adev mdev [1e-12]  tdev [ps]\r\n");
+    for (int k = 0; k < LEVELS; ++k)
+        {
+        if (lev[k].n == 0)
+            {
+            break;
+            }
+        std::printf("%5d %6lu %9ld %9ld %9ld\r\n", tau(k), (unsigned long) lev[k].n,
+                std::lround(adev(k) / freq * 1e12), std::lround(mdev(k) / freq * 1e12),
+                std::lround(tdev(k) / freq * 1e12));
+        }
+    }
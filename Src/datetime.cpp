@@ -13,6 +13,9 @@
  * 21-10-17 fix error in ctor, tested leap second                     v. 1.00
  */
 
+#include <algorithm>
+#include <charconv>
+#include <cstring>
 #include "datetime.h"
 
 const std::string L_TIME[] = {"?", "CET", "CEST"};
@@ -293,24 +296,43 @@ bool Date_time::setSummerStart()
     return true;
     }
 
-std::string Date_time::getDateStr()
+std::string_view Date_time::getDateStr(char *buf, int size) const
     {
-    if (year == 0) return "";
-
-    std::string ans = THE_WEEKD[get_wday()];
-    ans += ", ";
-    ans += THE_MONTHS[month];
-    ans += " ";
-    ans += std::to_string(day);
-    ans += ", ";
-    ans += std::to_string(2000 + year);
+    int len = 0;
+
+    auto str = [&](std::string_view s)
+        {
+            int n = std::min<int>(s.size(), size - len);
+            std::memcpy(buf + len, s.data(), n);
+            len += n;
+        };
+
+    auto num = [&](int v)
+        {
+            auto res = std::to_chars(buf + len, buf + size, v);
+            if (res.ec == std::errc())
+                {
+                len = res.ptr - buf;
+                }
+        };
+
+    if (year == 0) return {};
+
+    str(THE_WEEKD[get_wday()]);
+    str(", ");
+    str(THE_MONTHS[month]);
+    str(" ");
+    num(day);
+    str(", ");
+    num(2000 + year);
     if (!useUTC)
         {
-        ans += "  (";
-        ans += L_TIME[isSu ? 2 : 1];
-        ans += ")";
+        str("  (");
+        str(L_TIME[isSu ? 2 : 1]);
+        str(")");
         }
-    return ans;
+
+    return {buf, (size_t) len};
     }
 
 //Date_time fromS2W(const Date_time &dt)
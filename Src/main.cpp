@@ -36,7 +36,8 @@
  * so t = 1/f = 11.1ns, in practice ± 50ns is observed. Then, datasheet says that
  * interrupt takes 12 clock = 12 / 180MHz = 66.7ns [we ignore this]).
  *
- * PA8 (D7)------> PPS
+ * PA8 (D7)------> PPS (EXTI)
+ * PA15 (CN7 pin 17) --> PPS (TIM2_CH1 input capture, wire from PA8)
  *
  */
 
@@ -48,12 +49,13 @@
 #include <GPS_Init.h>
 #include <tim.h>
 #include <usart.h>
-#include "MoveSum.h"
-#include "average.h"
+#include "ClockServo.h"
 #include "datetime.h"
 #include "NDisplay.h"
 #include "GPS.h"
 #include "GPSsat.h"
+#include "PpsCapture.h"
+#include "Stability.h"
 
 /* Private variables ---------------------------------------------------------*/
 int rxdataSize;
@@ -63,14 +65,10 @@ int rxdataSize;
 const double _TIM_FREQ {90e6 + 3938};   // 39p  linear appr.  => 49.7p
 int CNT_SEC = {(int) std::round(_TIM_FREQ)};
 
-int old_av {0};
-float av;
-float a_av;
-float lav;
 
 // I want to separate interrupt, data processing and data gathering.
 const int DELTA {(int) std::round(0.5e-3 * _TIM_FREQ)};
-// read and save gps messages
+// gps messages are decoded when they come, READ_ZONE_END closes the second
 const int READ_ZONE_ST {(int) std::round(0.1 * _TIM_FREQ)};
 const int READ_ZONE_END {(int) std::round(0.45 * _TIM_FREQ)};
 const int WORK_ZONE_ST {(int) std::round(0.55 * _TIM_FREQ)};
@@ -89,11 +87,30 @@ int starter {0};
 // help variable for doing things only ones per second
 int progress {0};
 
+// seconds with good fix before PPS is used again
+const int FIX_SETTLE {5};
+int fix_settle {FIX_SETTLE};
+
 bool init_done {false};
 
-// variables for timer control
-MovSum<int, 2> mSum2;
-Average<double> avr;
+// timer control: phase (pps) => ARR
+ClockServo servo(_TIM_FREQ - 1, ClockServo::KALMAN);
+// timer was set at PPS again (start, TOO_BIG)
+bool restarted {true};
+
+// PPS watchdog: seconds counted by timer, second of the last PPS
+volatile uint32_t tim_sec {0};
+volatile uint32_t pps_sec {0};
+// no PPS: timer runs on the servo model, when PPS is back the phase is slewed, not set
+volatile bool holdover {false};
+
+// stability of the crystal against PPS: phase without the timer corrections
+Stability stab(_TIM_FREQ);
+double free_phase {0};
+
+// command from the terminal (UART2): s stability table, c clear it
+uint8_t term_rx;
+volatile uint8_t term_cmd {0};
 
 // timer value when PPS interrupt from GPS chip
 int pps {0};
@@ -116,19 +133,6 @@ void show_satellites();
 namespace tim
 {
 void set_time();
-
-// I want update display so little as possible, most time only last figure of second.
-struct Tm
-    {
-    int s10 = 0;
-    int os10 = -1;
-    int m = 0;
-    int om = -1;
-    int h = 0;
-    int oh = -1;
-    };
-
-Tm tm;
 }
 
 namespace nxt
@@ -147,6 +151,26 @@ NComp nsat0 = display.addComp(0, 10, "nsat");
 NComp txtDate = display.addComp(0, 5, "txtDate");
 NComp butPage1 = display.addComp(0, 12, "butPage2", sat::to_page1);
 NComp error = display.addComp(0, 13, "h0");
+NComp tm0 = display.addComp(0, 14, "tm0");
+
+/*! Seconds counted by Nextion: timer tm0 on page 0 (tim=1000, en=0) with Timer Event
+ *      ns1.val++
+ *      if(ns1.val>9)
+ *      {
+ *        ns1.val=0
+ *        ns2.val++
+ *        if(ns2.val>5)
+ *        {
+ *          ns2.val=0
+ *        }
+ *      }
+ * The MCU sends the time only at each minute (armed frame at PPS, timer restarted
+ * there), on page change and when the check at second 30 finds the display wrong.
+ * false => MCU sends every second. Set true only with tm0 in the HMI (see README).
+ */
+const bool DISPLAY_COUNTS {false};
+bool resync {true};
+uint32_t drift_errors {0};
 
 //       page 1
 NComp nsat1 = display.addComp(1, 2, "nsat");
@@ -170,40 +194,90 @@ NComp snr6 = display.addComp(1, 13, "snr6");
 NComp snr7 = display.addComp(1, 1, "snr7");
 NComp butPage0 = display.addComp(1, 4, "butPage0", sat::to_page0);
 
-void show_date(bool force = false)
+// display keeps what it shows, so only changed figures go out (mostly last of second)
+void show_date(Date_time &t)
+    {
+    std::div_t s10s1 = std::div(t.getSec(), 10);
+
+    // all changed figures in one transfer
+    display.beginBatch();
+
+    ns1.setVal(s10s1.rem);
+    ns2.setVal(s10s1.quot);
+    nm.setVal(t.getMinute());
+    nh.setVal(t.getHour());
+
+    // date text made only when the day changes or the page was shown again
+    static int dateKey {-1};
+    int key = ((t.getYear() * 16 + t.getMonth()) * 32 + t.getDay()) * 4 + t.isSummer() * 2
+            + t.useUTC;
+    if (key != dateKey || !txtDate.textShown())
+        {
+        char date[40];
+        txtDate.setText(t.getDateStr(date, sizeof(date)));
+        dateKey = key;
+        }
+
+    display.commitBatch();
+    }
+
+// next second made now, sent by PPS interrupt: the change comes always same time after
+// the second
+void arm_next_second()
     {
-    std::div_t s10s1;
+    Date_time next(dt);
+    next.add_sec();
 
-    if (force)
+    if (DISPLAY_COUNTS && !resync && next.getSec() != 0)
         {
-        tim::tm.oh = tim::tm.om = tim::tm.os10 = -1;
+        // Nextion counts it
+        return;
         }
 
-    // minimal display output, only last second figure
-    s10s1 = std::div(dt.getSec(), 10);
-    ns1.setVal(s10s1.rem);
+    if (!display.beginArm())
+        {
+        return;
+        }
 
-    if (tim::tm.os10 != s10s1.quot)
+    if (DISPLAY_COUNTS)
         {
-        ns2.setVal(s10s1.quot);
-        tim::tm.os10 = s10s1.quot;
+        // no tick of the old timer while the frame is coming
+        display.sendCommand("tm0.en=0");
+        // seconds on screen come from tm0, not from the cache
+        ns1.invalidate();
+        ns2.invalidate();
         }
 
-    tim::tm.m = dt.getMinute();
-    if (tim::tm.om != tim::tm.m)
+    show_date(next);
+
+    if (DISPLAY_COUNTS)
         {
-        nm.setVal(tim::tm.m);
-        tim::tm.om = tim::tm.m;
-//        get_s_corr(tim::tm.h, tim::tm.m);
+        // timer from the PPS on, last in the frame
+        display.sendCommand("tm0.tim=1000");
+        display.sendCommand("tm0.en=1");
+        resync = false;
         }
 
-    tim::tm.h = dt.getHour();
-    if (tim::tm.oh != tim::tm.h)
+    display.endArm();
+    }
+
+// answer to get ns1.val: display counted right?
+void check_ns1(void*, bool ok, int32_t val, std::string_view)
+    {
+    if (!ok || val != dt.getSec() % 10)
         {
+        ++drift_errors;
+        printf("display drift: %ld at :%02d\r\n", val, dt.getSec());
+        resync = true;
+        }
+    }
 
-        nh.setVal(tim::tm.h);
-        tim::tm.oh = tim::tm.h;
-        txtDate.setText(dt.getDateStr().c_str());
+// Nextion timer vs. PPS, once a minute in work zone
+void check_display()
+    {
+    if (DISPLAY_COUNTS && !resync && dt.getSec() == 30)
+        {
+        ns1.getValAsync(check_ns1);
         }
     }
 
@@ -211,47 +285,39 @@ void show_date(bool force = false)
 
 namespace sat
 {
-const unsigned NB_SAT_SHOW = 8;
-
-int id_old[8] {-1, -1, -1, -1, -1, -1, -1, -1};
-int snr_old[8] {-1, -1, -1, -1, -1, -1, -1, -1};
+const unsigned NB_SAT_SHOW = SVs::NB_STRONG;
+// biggest batch seen
+uint32_t max_batch {0};
 
-std::tuple<const NComp&, const NComp&> graf[8] { {nxt::id0, nxt::snr0}, {nxt::id1,
-        nxt::snr1}, {nxt::id2, nxt::snr2}, {nxt::id3, nxt::snr3}, {nxt::id4, nxt::snr4}, {
-        nxt::id5, nxt::snr5}, {nxt::id6, nxt::snr6}, {nxt::id7, nxt::snr7}};
+std::tuple<const NComp&, const NComp&> graf[NB_SAT_SHOW] { {nxt::id0, nxt::snr0}, {
+        nxt::id1, nxt::snr1}, {nxt::id2, nxt::snr2}, {nxt::id3, nxt::snr3}, {nxt::id4,
+        nxt::snr4}, {nxt::id5, nxt::snr5}, {nxt::id6, nxt::snr6}, {nxt::id7, nxt::snr7}};
 
 void show_page1_SNR()
     {
 
     if (page_nb == 1 && GPS::has_sat_data())
         {
-        unsigned int sz = SVs::strongest_sats.size();
-        unsigned int to = std::min(NB_SAT_SHOW, sz);
+        // bars and sky plot in one transfer
+        display.beginBatch();
 
-        for (uint32_t i = 0; i < to; ++i)
+        // empty places give 0, bars which didn't change are not sent by display
+        for (uint32_t i = 0; i < NB_SAT_SHOW; ++i)
             {
-            if (i < sz)
-                {
-
-                if (SVs::strongest_sats[i].id != id_old[i]
-                        || SVs::strongest_sats[i].snr != snr_old[i])
-                    {
-                    id_old[i] = SVs::strongest_sats[i].id;
-                    snr_old[i] = SVs::strongest_sats[i].snr;
-                    std::get<0>(graf[i]).setVal(id_old[i]);
-                    std::get<1>(graf[i]).setVal(snr_old[i]);
-                    }
-                }
-            else
-                {
-                id_old[i] = 0;
-                snr_old[i] = 0;
-                std::get<0>(graf[i]).setVal(0);
-                std::get<0>(graf[i]).setVal(0);
-                }
+            Strong s = SVs::strongest_sats[i];
+            std::get<0>(graf[i]).setVal(s.id);
+            std::get<1>(graf[i]).setVal(s.snr);
             }
 
         sat::show_satellites();
+
+        display.commitBatch();
+        if (display.batchCmds > max_batch)
+            {
+            max_batch = display.batchCmds;
+            printf("page 1 batch: %lu cmd, %lu B\r\n", display.batchCmds,
+                    display.batchBytes);
+            }
         }
     }
 
@@ -264,23 +330,23 @@ void show_satellites()
 
     nxt::nsat1.setVal(GPS::gps_sattNumb);
 
-    for (auto &id_sat : SVs::old_spaceVehicles)
+    for (int id : SVs::old_spaceVehicles)
         {
-        id_sat.second.flag = 0;
+        SVs::old_spaceVehicles[id].flag = 0;
         }
 
-    for (const auto &s_new : SVs::new_spaceVehicles)
+    for (int id : SVs::new_spaceVehicles)
         {
-        int id = s_new.first;
+        const GPSsat &s_new = SVs::new_spaceVehicles[id];
         if (SVs::old_spaceVehicles.contains(id))
             {
             // check  elevation and azimuth and signal to noise ratio
-            if (s_new.second == SVs::old_spaceVehicles[id])
+            if (s_new == SVs::old_spaceVehicles[id])
                 {
                 continue;
                 }
 
-            if (!s_new.second.is_moved(SVs::old_spaceVehicles[id]))
+            if (!s_new.is_moved(SVs::old_spaceVehicles[id]))
                 {
                 SVs::old_spaceVehicles[id].flag = GPSsat::P;
                 }
@@ -292,7 +358,7 @@ void show_satellites()
             }
         else
             {
-            SVs::old_spaceVehicles.insert(s_new);
+            SVs::old_spaceVehicles.insert(id, s_new);
             // a new satellite, only paint
             SVs::old_spaceVehicles[id].flag = GPSsat::P;
             }
@@ -304,24 +370,30 @@ void show_satellites()
 void to_page0()
     {
     page_nb = 0;
+    // page shows its defaults
+    display.invalidate(0);
+    nxt::resync = true;
     display.sendCommand("page 0");
+    // next commands are for the new page
+    display.flush();
     }
 
 void to_page1()
     {
     page_nb = 1;
+    // next second for page 0
+    display.disarm();
     SVs::old_spaceVehicles.clear();
-    for (auto &sat : SVs::old_spaceVehicles)
+    for (int id : SVs::old_spaceVehicles)
         {
-        SVs::erase_sat(sat.second, display);
+        SVs::erase_sat(SVs::old_spaceVehicles[id]);
         }
 
-    id_old[0] = id_old[1] = id_old[2] = id_old[3] = id_old[4] = id_old[5] = id_old[6] =
-            id_old[7] = -1;
-    snr_old[0] = snr_old[1] = snr_old[2] = snr_old[3] = snr_old[4] = snr_old[5] =
-            snr_old[6] = snr_old[7] = -1;
+    // all bars are new on the page
+    display.invalidate(1);
 
     display.sendCommand("page 1");
+    display.flush();
     }
 
 } //namespace sat
@@ -354,9 +426,35 @@ int _write(int file, char *ptr, int len)
 }
 #endif
 
-float pidVal = 0;
-int iav;
-int corr;
+uint32_t tx_blocked {0};
+
+/*!
+ * \fn void tune_servo()
+ * \brief loop time constant from the measured noises
+ *
+ * AVAR = 3 r / tau^2 + q_f tau / 3: white PPS phase r from tau 1 s, frequency
+ * random walk q_f from the ADEV minimum.
+ */
+void tune_servo()
+    {
+    int k = stab.best_level();
+    if (k < 1)
+        {
+        return;
+        }
+
+    double t = Stability::tau(k);
+    double r = stab.avar(0) / 3;
+    double qf = 3 * (stab.avar(k) - 3 * r / (t * t)) / t;
+    if (qf <= 0)
+        {
+        return;
+        }
+
+    servo.tune(r, qf);
+    printf("servo tau %d s (adev min %d s)\r\n", (int) std::lround(servo.loop_tau()),
+            (int) t);
+    }
 
 /*!
  * @brief  The application entry point.
@@ -377,6 +475,7 @@ int main(void)
 
     MX_TIM2_Init();
     HAL_TIM_Base_Start_IT(&htim2);
+    HAL_UART_Receive_IT(&huart2, &term_rx, 1);
 
     printf("\x1b[2J\x1b[H");
 
@@ -402,6 +501,8 @@ int main(void)
         }
 
 keepgoing:
+    // after GPS UART init: its MspInit must not take the capture pin
+    ppscap::init();
 
 //Initialize Nextion with the configured UART and DMA handle
     display.init(&huart3, &hdma_usart3_rx);
@@ -421,8 +522,12 @@ keepgoing:
 // _______________________     forever     _______________________
     for (;;)
         {
+        // Nextion events (touch callbacks) and get answers, out of interrupt
+        display.poll();
+
         if (starter < PULS_NMB)
             {
+            restarted = true;
             HAL_Delay(50);
             continue;
             }
@@ -440,13 +545,17 @@ keepgoing:
             continue;
             }
 
-        // show date on display short after second starts
+        // time is on display (armed frame sent by PPS), if not: show it now
         if (progress == 0)
             {
             ++progress;
-            if (page_nb == 0)
+            GPS::begin_epoch();
+            // in counting mode only if the armed frame was not sent
+            if (page_nb == 0 && (!nxt::DISPLAY_COUNTS || display.isArmed()))
                 {
-                nxt::show_date();
+                display.disarm();
+                nxt::resync = true;
+                nxt::show_date(dt);
                 }
             continue;
             }
@@ -466,8 +575,9 @@ keepgoing:
                 {
             case 0:
                 nxt::error.setVal(std::clamp(0, 200, (int) (ERR_A * pps + 100)));
-                nxt::show_date(true);
                 nxt::nsat0.setVal(GPS::gps_sattNumb);
+                nxt::check_display();
+                nxt::arm_next_second();
                 break;
 
             case 1:
@@ -478,38 +588,134 @@ keepgoing:
                 break;
                 }
 
-            pidVal = 0;
+            // main loop time lost in sending to Nextion, average of last minute
+            tx_blocked += display.txBlockedUs;
+            display.txBlockedUs = 0;
+            if (dt.getSec() == 0)
+                {
+                printf("tx blocked %lu us/s, full %lu, sent %lu, same %lu\r\n",
+                        tx_blocked / 60, display.txFull, display.cmdSent,
+                        display.cmdSuppressed);
+                printf("rx isr max %lu cycles\r\n", display.rxIsrMax);
+                // sky plot repaint, average of last minute and last frame
+                printf("sky %lu B/s, last frame %lu B in %lu cmds\r\n",
+                        SkyComp::total_bytes / 60, SkyComp::frame_bytes,
+                        SkyComp::frame_cmds);
+                SkyComp::total_bytes = 0;
+
+                if (dt.getMinute() == 0)
+                    {
+                    printf("display %lu B/h, drift errors %lu\r\n", display.txBytes,
+                            nxt::drift_errors);
+                    display.txBytes = 0;
+                    }
 
-            mSum2.addItem(pps);
+                // PPS -> time on display, bins of 250 us
+                if (dt.getMinute() % 10 == 0)
+                    {
+                    ppscap::print_hist();
+                    printf("pps->tx max %lu us, lost %lu:", display.armLatMax,
+                            display.armLost);
+                    for (int i = 0; i < NDisplay::LAT_BINS; ++i)
+                        {
+                        if (display.armLatency[i] != 0)
+                            {
+                            printf(" %d:%lu", i * NDisplay::LAT_BIN_US,
+                                    display.armLatency[i]);
+                            }
+                        }
+                    printf("\r\n");
+                    }
+                tx_blocked = 0;
+                }
 
-            if (avr.addItem(pps))
+            if (restarted)
                 {
-                av = avr.getAvr();
-                iav = (int) std::round(av);
-                printf("%02d:%02d %d\r\n", dt.getHour(), dt.getMinute(), iav);
-                CNT_SEC += iav;
+                // phase is 0 again, frequency is still good
+                servo.restart();
+                stab.gap();
+                free_phase = 0;
+                restarted = false;
                 }
 
-            av = avr.getAvr();
-            iav = (int) std::round(av);
-            a_av = std::abs(av);
-            lav = std::log10(a_av);
-
-            if (iav != old_av)
+            // PPS watchdog, no PPS in this second
+            if (tim_sec != pps_sec)
                 {
-                old_av = iav;
-                printf("%d\r\n", iav);
+                if (!holdover)
+                    {
+                    holdover = true;
+                    printf("%02d:%02d PPS lost, holdover\r\n", dt.getHour(),
+                            dt.getMinute());
+                    }
+                fix_settle = FIX_SETTLE;
                 }
-
-            if (lav > 2)
+            // PPS in bad or no fix is not used, timer runs on the frequency
+            else if (!GPS::fix_good())
                 {
-                av /= lav;
+                if (fix_settle == 0)
+                    {
+                    printf("fix lost q:%d n:%d hdop:%d\r\n", GPS::fix_quality,
+                            GPS::sats_used, GPS::hdop);
+                    }
+                fix_settle = FIX_SETTLE;
                 }
 
-            corr = (int) std::round((float) mSum2.getSum() / 7.0 + av);
+            if (fix_settle > 0)
+                {
+                --fix_settle;
+                actualSec = servo.hold();
+                stab.gap();
+                free_phase = 0;
+                }
+            else
+                {
+                if (servo.held() > 0)
+                    {
+                    printf("%02d:%02d PPS used after %d s: phase %d ticks, estimated +-%ld\r\n",
+                            dt.getHour(), dt.getMinute(), servo.held(), pps,
+                            std::lround(servo.error()));
+                    }
+                stab.add(pps + free_phase);
+                actualSec = servo.update(pps);
 
-            actualSec = CNT_SEC + corr;
+                // slewed back, big difference resets the timer again
+                if (holdover && std::abs(pps) <= TOO_BIG)
+                    {
+                    holdover = false;
+                    }
+                }
             TIM2->ARR = actualSec;
+            free_phase += actualSec - CNT_SEC;
+
+            switch (term_cmd)
+                {
+            case 's':
+                stab.print();
+                break;
+            case 'c':
+                stab.clear();
+                printf("stability cleared\r\n");
+                break;
+            default:
+                break;
+                }
+            term_cmd = 0;
+
+            if (dt.getSec() == 0)
+                {
+                printf("%02d:%02d f %ld phase %d\r\n", dt.getHour(), dt.getMinute(),
+                        std::lround(servo.freq()), (int) std::lround(servo.phase()));
+                if (servo.held() > 0)
+                    {
+                    printf("holdover %d s, error +-%ld ticks\r\n", servo.held(),
+                            std::lround(servo.error()));
+                    }
+                if (dt.getMinute() == 0)
+                    {
+                    printf("aging %ld mHz/day\r\n", std::lround(servo.drift() * 86400e3));
+                    tune_servo();
+                    }
+                }
             }
         } //for (;;)
     } //int main(void)
@@ -692,10 +898,9 @@ void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size)
 
         trx = TIM2->CNT;
 
-        if (trx > READ_ZONE_ST && trx < READ_ZONE_END)
-            {
-            GPS::save(Size);
-            }
+        // whole sentences are decoded on the fly, the data of this second are taken in
+        // between GPS::begin_epoch() and GPS::read_data()
+        GPS::stream_data(GPS::gps_rx, Size);
 
 //     restart idle DMA receive, disable half buffer interrupt
 restart:
@@ -704,25 +909,76 @@ restart:
         }
     }
 
+// byte from the terminal, done in the work zone
+void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
+    {
+    if (huart->Instance == USART2)
+        {
+        term_cmd = term_rx;
+        HAL_UART_Receive_IT(huart, &term_rx, 1);
+        }
+    }
+
+// overrun (terminal typed during printf) stops the receive
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
+    {
+    if (huart->Instance == USART2)
+        {
+        HAL_UART_Receive_IT(huart, &term_rx, 1);
+        }
+    else if (huart->Instance == USART3)
+        {
+        // DMA error ends the transmit, overrun / noise / framing the receive
+        if (huart->gState == HAL_UART_STATE_READY)
+            {
+            display.txError();
+            }
+        if (huart->RxState == HAL_UART_STATE_READY)
+            {
+            display.waitRxEvent();
+            }
+        }
+    }
+
+// Nextion TX DMA done, send the rest of the queue
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
+    {
+    if (huart->Instance == USART3)
+        {
+        display.processTx(huart);
+        }
+    }
+
 void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *th)
     {
-    if (init_done && th->Instance == TIM2)
+    if (th->Instance == TIM2)
         {
-        dt.add_sec();
+        ppscap::tick();
+        tim_sec = tim_sec + 1;
+        if (init_done)
+            {
+            dt.add_sec();
+            }
         }
     }
 
 /*!
- * \fn void HAL_GPIO_EXTI_Callback(uint16_t)
- * \brief PPS interrupt callback
+ * \fn void on_pps(int)
+ * \brief PPS came, timer counted cnt
  *
- * \param GPIO_Pin Pin that caused interrupt
+ * \param cnt TIM2 count at PPS: captured by hardware or read in EXTI
  */
-void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
+void on_pps(int cnt)
     {
+    // early PPS (before timer update) is of the next second
+    pps_sec = cnt > half ? tim_sec + 1 : tim_sec;
+
     if (starter > PULS_NMB)
         {
-        pps = TIM2->CNT;
+        pps = cnt;
+
+        // new second on display
+        display.fireArmed();
 
         pps -= DELTA;
 
@@ -731,7 +987,8 @@ void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
             pps -= actualSec;
             }
 
-        if (std::abs(pps) > TOO_BIG)
+        // after holdover the phase is slewed back
+        if (std::abs(pps) > TOO_BIG && !holdover)
             {
             starter = 0;
             }
@@ -743,3 +1000,36 @@ void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
         pps = 0;
         }
     }
+
+/*!
+ * \fn void HAL_TIM_IC_CaptureCallback(TIM_HandleTypeDef*)
+ * \brief PPS on TIM2_CH1, count latched by the timer
+ *
+ * \param htim timer handle
+ */
+void HAL_TIM_IC_CaptureCallback(TIM_HandleTypeDef *htim)
+    {
+    if (htim->Instance == TIM2 && htim->Channel == HAL_TIM_ACTIVE_CHANNEL_1)
+        {
+        uint32_t cnt = HAL_TIM_ReadCapturedValue(htim, TIM_CHANNEL_1);
+        ppscap::from_capture(cnt);
+        on_pps(cnt);
+        }
+    }
+
+/*!
+ * \fn void HAL_GPIO_EXTI_Callback(uint16_t)
+ * \brief PPS interrupt callback, used if there is no capture
+ *
+ * \param GPIO_Pin Pin that caused interrupt
+ */
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
+    {
+    uint32_t cnt = TIM2->CNT;
+    ppscap::from_exti(cnt);
+
+    if (!ppscap::active())
+        {
+        on_pps(cnt);
+        }
+    }
@@ -0,0 +1,34 @@
+/*!
+ * \file alloc_count.cpp
+ * \brief Counting global operator new / delete.
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <cstdlib>
+#include <new>
+#include "alloc_count.h"
+
+std::size_t alloc::calls {0};
+std::size_t alloc::bytes {0};
+
+void* operator new(std::size_t n)
+    {
+    ++alloc::calls;
+    alloc::bytes += n;
+    if (void *p = std::malloc(n ? n : 1))
+        {
+        return p;
+        }
+    throw std::bad_alloc();
+    }
+
+void operator delete(void *p) noexcept
+    {
+    std::free(p);
+    }
+
+void operator delete(void *p, std::size_t) noexcept
+    {
+    std::free(p);
+    }
@@ -0,0 +1,21 @@
+/*!
+ * \file alloc_count.h
+ * \brief Heap use of the code under test: global operator new counted
+ * (alloc_count.cpp linked in).
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef TEST_ALLOC_COUNT_H_
+#define TEST_ALLOC_COUNT_H_
+
+#include <cstddef>
+
+namespace alloc
+{
+// calls of operator new and bytes asked, since start
+extern std::size_t calls;
+extern std::size_t bytes;
+}
+
+#endif /* TEST_ALLOC_COUNT_H_ */
@@ -0,0 +1,26 @@
+/*!
+ * \file bench.h
+ * \brief Timing of host benchmarks.
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef TEST_BENCH_H_
+#define TEST_BENCH_H_
+
+#include <chrono>
+
+// mean ns of one call of f, n calls
+template<typename F>
+double ns_per(int n, F f)
+    {
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; ++i)
+        {
+        f();
+        }
+    std::chrono::duration<double, std::nano> d = std::chrono::steady_clock::now() - t0;
+    return d.count() / n;
+    }
+
+#endif /* TEST_BENCH_H_ */
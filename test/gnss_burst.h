@@ -0,0 +1,158 @@
+/*!
+ * \file gnss_burst.h
+ * \brief Synthetic NMEA output of a multi-GNSS receiver (GN RMC/GGA/GSA, GSV per
+ * system), for the benchmarks of the NMEA path and of the sky plot.
+ *
+ * Satellites move on a smooth sky (slow azimuth and elevation drift), so one second
+ * against the next looks as it does on the receiver.
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef TEST_GNSS_BURST_H_
+#define TEST_GNSS_BURST_H_
+
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace burst
+{
+struct Sv
+    {
+    int prn;    // NMEA number (GLONASS 65.., BeiDou 201.., Galileo 301..)
+    int el;
+    int az;
+    int snr;
+    };
+
+// talker, first NMEA PRN, system ID of GSA (NMEA 4.1)
+struct System
+    {
+    const char *talker;
+    int prn0;
+    int gsaId;
+    };
+
+const System SYSTEMS[] { {"GP", 1, 1}, {"GL", 65, 2}, {"GA", 301, 3}, {"GB", 201, 4}};
+
+// "$" body "*hh\r\n"
+inline std::string line(const std::string &body)
+    {
+    unsigned sum = 0;
+    for (char c : body)
+        {
+        sum ^= (unsigned char) c;
+        }
+
+    char cs[8];
+    std::snprintf(cs, sizeof(cs), "*%02X\r\n", sum);
+    return "$" + body + cs;
+    }
+
+// GSV messages of one system, 4 satellites per message
+inline std::string gsv(const char *talker, const std::vector<Sv> &svs)
+    {
+    int tot = svs.empty() ? 1 : (svs.size() + 3) / 4;
+    std::string out;
+
+    for (int m = 0; m < tot; ++m)
+        {
+        char b[100];
+        int n = std::snprintf(b, sizeof(b), "%sGSV,%d,%d,%02zu", talker, tot, m + 1,
+                svs.size());
+        for (std::size_t i = m * 4; i < svs.size() && i < (std::size_t) m * 4 + 4; ++i)
+            {
+            const Sv &s = svs[i];
+            n += std::snprintf(b + n, sizeof(b) - n, ",%02d,%02d,%03d,%02d", s.prn, s.el,
+                    s.az, s.snr);
+            }
+        out += line(b);
+        }
+
+    return out;
+    }
+
+/*!
+ * \brief satellites of one system at second t
+ *
+ * \param sys index in SYSTEMS
+ * \param nb satellites in view
+ * \param t second (of a day), moves the sky
+ */
+inline std::vector<Sv> sky(int sys, int nb, int t)
+    {
+    std::vector<Sv> svs;
+
+    for (int i = 0; i < nb; ++i)
+        {
+        // each satellite its own track, a pass takes some hours
+        double ph = 2 * M_PI * (t / 21600.0 + i * 0.137 + sys * 0.31);
+        int el = std::lround(45 + 44 * std::sin(ph));
+        int az = std::lround(i * 37 + sys * 11 + t / 240.0) % 360;
+        int snr = std::lround(20 + el / 3.0 + 5 * std::sin(ph * 7));
+        svs.push_back( {SYSTEMS[sys].prn0 + i, el, az, snr});
+        }
+
+    return svs;
+    }
+
+/*!
+ * \brief one second of output
+ *
+ * \param systems GP only (1) up to GP+GL+GA+GB (4)
+ * \param perSys satellites in view per system
+ * \param t second of the day
+ */
+inline std::string second(int systems, int perSys, int t)
+    {
+    char b[100];
+    int hh = t / 3600 % 24;
+    int mm = t / 60 % 60;
+    int ss = t % 60;
+    const char *tk = systems > 1 ? "GN" : "GP";
+    std::string out;
+
+    std::snprintf(b, sizeof(b), "%sRMC,%02d%02d%02d.000,A,2307.1256,N,12016.4438,E,0.03,"
+            "165.48,181026,,,A", tk, hh, mm, ss);
+    out += line(b);
+    std::snprintf(b, sizeof(b), "%sGGA,%02d%02d%02d.000,2307.1256,N,12016.4438,E,1,%02d,"
+            "0.95,39.9,M,17.8,M,,", tk, hh, mm, ss, systems * perSys);
+    out += line(b);
+
+    for (int s = 0; s < systems; ++s)
+        {
+        int n = std::snprintf(b, sizeof(b), "%sGSA,A,3", tk);
+        for (int i = 0; i < 12; ++i)
+            {
+            if (i < perSys)
+                {
+                n += std::snprintf(b + n, sizeof(b) - n, ",%02d", SYSTEMS[s].prn0 + i);
+                }
+            else
+                {
+                n += std::snprintf(b + n, sizeof(b) - n, ",");
+                }
+            }
+        if (systems > 1)
+            {
+            std::snprintf(b + n, sizeof(b) - n, ",1.60,0.95,1.29,%d", SYSTEMS[s].gsaId);
+            }
+        else
+            {
+            std::snprintf(b + n, sizeof(b) - n, ",1.60,0.95,1.29");
+            }
+        out += line(b);
+        }
+
+    for (int s = 0; s < systems; ++s)
+        {
+        out += gsv(SYSTEMS[s].talker, sky(s, perSys, t));
+        }
+
+    return out;
+    }
+}
+
+#endif /* TEST_GNSS_BURST_H_ */
@@ -0,0 +1,121 @@
+/*!
+ * \file gnss_throughput_bench.cpp
+ * \brief Multi-GNSS NMEA: GP only against GP+GL+GA+GB bursts, old split() path
+ * against the GPS decode (NmeaStream + tag hash + handlers).
+ *
+ * A multi-GNSS second is 3..4 times the GP one and longer than the DMA buffer; it is
+ * fed in RXSZ chunks as the UART idle events give it, every system must be decoded.
+ * The old path only knew $GPRMC and $GPGSV, how many sentences it used is printed.
+ */
+
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include "bench.h"
+#include "gnss_burst.h"
+#include "nmea_old.h"
+#include "GPS.h"
+
+#define CHECK(c) if (!(c)) { std::printf("FAIL line %d: %s\n", __LINE__, #c); return 1; }
+
+// main.cpp has it, the sky plot draws on it
+NDisplay display;
+
+namespace
+{
+// 115200 baud, 8N1
+const double LINK_BPS {11520};
+
+// old GPS::parse_sentences with check_what_sentence: sentences it decoded
+int old_used(std::string_view packet)
+    {
+    int nb = 0;
+
+    for (auto l : old::split(packet, "\r\n"))
+        {
+        if (!old::cntrCheckSum(l))
+            {
+            continue;
+            }
+
+        auto f = old::split(l, ",");
+        if (f[0] == "$GPRMC" || f[0] == "$GPGSV")
+            {
+            ++nb;
+            }
+        }
+
+    return nb;
+    }
+
+void decode(const std::string &s)
+    {
+    GPS::begin_epoch();
+    for (std::size_t i = 0; i < s.size(); i += GPS::RXSZ)
+        {
+        std::size_t n = std::min<std::size_t>(GPS::RXSZ, s.size() - i);
+        GPS::stream_data((const uint8_t*) s.data() + i, n);
+        }
+    GPS::read_data();
+    }
+}
+
+int main()
+    {
+    struct Case
+        {
+        int systems;
+        int perSys;
+        };
+    const Case CASES[] { {1, 12}, {4, 8}, {4, 10}, {4, 12}};
+    const int N {20000};
+    double gpBytes = 0;
+
+    for (const auto &c : CASES)
+        {
+        std::string s = burst::second(c.systems, c.perSys, 43200);
+        int sentences = 0;
+        for (char ch : s)
+            {
+            sentences += ch == '\n';
+            }
+
+        uint32_t err0 = GPS::stream.getErrors();
+        decode(s);
+        CHECK(GPS::stream.getErrors() == err0);
+        CHECK((GPS::acquired & GPS::ALL_OK) == GPS::ALL_OK);
+        CHECK(GPS::gps_sattNumb == c.systems * c.perSys);
+        CHECK(SVs::new_spaceVehicles.size() == c.systems * c.perSys);
+        for (int sys = 0; sys < c.systems; ++sys)
+            {
+            CHECK(GPS::is_used((gnss::Sys) sys, 1));
+            }
+
+        int oldUsed = old_used(s);
+        if (c.systems == 1)
+            {
+            gpBytes = s.size();
+            }
+
+        volatile int sink = 0;
+        double tOld = ns_per(N, [&]
+            {
+            int f = 0;
+            sink = sink + old::tokenize(s, f);
+            });
+        double tNew = ns_per(N, [&]
+            {
+            decode(s);
+            });
+
+        std::printf("%d x %2d SVs: %4zu bytes (%.1fx GP, %2.0f%% of the link, %.1f DMA "
+                "buffers), %2d sentences, old used %2d\n", c.systems, c.perSys, s.size(),
+                s.size() / gpBytes, 100 * s.size() / LINK_BPS, double(s.size()) / GPS::RXSZ,
+                sentences, oldUsed);
+        std::printf("    old split (no handlers): %6.1f us/s, %5.1f MB/s | "
+                "GPS decode: %6.1f us/s, %5.1f MB/s\n", tOld / 1e3, s.size() * 1e3 / tOld, tNew / 1e3,
+                s.size() * 1e3 / tNew);
+        }
+
+    return 0;
+    }
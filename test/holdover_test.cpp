@@ -0,0 +1,106 @@
+/*!
+ * \file holdover_test.cpp
+ * \brief Time error of ClockServo::hold() after 1 h and 24 h without PPS.
+ *
+ * 7 days locked on the simulated oscillator (osc_sim.h, 4.5 ticks PPS noise), the
+ * servo tuned to its noises, then holdover; RMS over 20 seeds, for two random walks
+ * of the frequency, without and with aging 1e-5 tick/s^2. The aging is learned, so it
+ * must not add to the error, and none is learned without it (the learned one only
+ * has the noise of the walk); error() must be near the real error.
+ */
+
+#include <cmath>
+#include <cstdio>
+#include "ClockServo.h"
+#include "osc_sim.h"
+
+#define CHECK(c) if (!(c)) { std::printf("FAIL line %d: %s\n", __LINE__, #c); return 1; }
+
+namespace
+{
+const int LOCKED {7 * 86400};
+const int DAY {86400};
+const int HOUR {3600};
+const int SEEDS {20};
+// ticks in 1 us
+const double US {90.0};
+// PPS white noise [ticks]
+const double WP {4.5};
+
+struct Result
+    {
+    double rms1h;
+    double rms24h;
+    double est24h;
+    double aging;
+    // spread of the learned aging over the seeds
+    double agingSd;
+    };
+
+Result run(double rw, double aging)
+    {
+    Result res {};
+
+    for (int seed = 1; seed <= SEEDS; ++seed)
+        {
+        OscSim osc(ARR0 + 150, aging, rw, WP, seed);
+        ClockServo servo(ARR0);
+        // noises as Allan deviation would give them, PPS rounded to ticks
+        servo.tune(WP * WP + 1.0 / 12, rw * rw);
+        int u = ARR0;
+
+        for (int k = 0; k < LOCKED; ++k)
+            {
+            u = servo.update(osc.step(u));
+            }
+        res.aging += servo.drift() / SEEDS;
+        res.agingSd += servo.drift() * servo.drift() / SEEDS;
+
+        double x0 = osc.x;
+        for (int k = 1; k <= DAY; ++k)
+            {
+            osc.step(u);
+            u = servo.hold();
+            if (k == HOUR)
+                {
+                res.rms1h += (osc.x - x0) * (osc.x - x0) / SEEDS;
+                }
+            }
+        res.rms24h += (osc.x - x0) * (osc.x - x0) / SEEDS;
+        res.est24h += servo.error() / SEEDS;
+        }
+
+    res.agingSd = std::sqrt(res.agingSd - res.aging * res.aging);
+    res.rms1h = std::sqrt(res.rms1h);
+    res.rms24h = std::sqrt(res.rms24h);
+    return res;
+    }
+}
+
+int main()
+    {
+    for (double rw : {0.0005, 0.005})
+        {
+        Result flat = run(rw, 0);
+        Result aged = run(rw, 1e-5);
+
+        for (const Result &r : {flat, aged})
+            {
+            std::printf("rw %g: 1 h %6.1f us, 24 h %7.1f us RMS, error() %7.1f us, "
+                    "aging learned %.2e +- %.2e\n", rw, r.rms1h / US, r.rms24h / US,
+                    r.est24h / US, r.aging, r.agingSd);
+            // servo tuned to the oscillator: error() is the real error, roughly
+            CHECK(r.est24h > 0.5 * r.rms24h && r.est24h < 3 * r.rms24h);
+            }
+
+        // random walk only: ~2 us per 0.001 tick/s/sqrt(s) in 1 h, ~255 us in 24 h
+        CHECK(flat.rms1h / US < rw * 3000 && flat.rms24h / US < rw * 3e5);
+        CHECK(std::fabs(aged.rms24h / flat.rms24h - 1) < 0.05);
+        // learned aging is noise of the random walk, not a bias: no aging learned
+        // without aging, the true one with it (3 sigma of the mean over the seeds)
+        CHECK(std::fabs(flat.aging) < 3 * flat.agingSd / std::sqrt(SEEDS));
+        CHECK(std::fabs(aged.aging - 1e-5) < 3 * aged.agingSd / std::sqrt(SEEDS));
+        }
+
+    return 0;
+    }
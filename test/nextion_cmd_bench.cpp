@@ -0,0 +1,155 @@
+/*!
+ * \file nextion_cmd_bench.cpp
+ * \brief Making Nextion commands: NCmd in a stack buffer against sprintf into TxData
+ * and the std::string which sendCommand took before, ns per command and heap; then
+ * the whole NComp::setVal (format, queue, DMA done) and the RAM of the components.
+ *
+ * setVal must not allocate. addComp only does for long names: NObject keeps the name
+ * and the two command beginnings as std::string, past the small string buffer they go
+ * to the heap.
+ */
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "alloc_count.h"
+#include "bench.h"
+#include "hal_fake.h"
+#include "NCmd.h"
+#include "NDisplay.h"
+
+#define CHECK(c) if (!(c)) { std::printf("FAIL line %d: %s\n", __LINE__, #c); return 1; }
+
+namespace
+{
+UART_HandleTypeDef huart;
+DMA_HandleTypeDef hdma;
+NDisplay display;
+
+// names of main.cpp, 2..7 chars
+const char *const SHORT[] {"ns1", "ns2", "nm", "nh", "nsat0", "nsat1", "txtDate",
+        "j0", "j1", "j2", "j3", "j4", "j5", "j6", "j7", "t0", "t1", "t2", "t3", "t4",
+        "t5", "t6", "t7", "n0", "n1", "n2", "n3", "n4", "bt0", "bt1"};
+const int NB {sizeof(SHORT) / sizeof(SHORT[0])};
+
+// sendCommand(const std::string&) and TxData before NCmd
+char TxData[100];
+
+std::size_t old_val(const std::string &name, int v)
+    {
+    std::sprintf(TxData, "%s.val=%d", name.c_str(), v);
+    std::string cmd(TxData);
+    return cmd.size();
+    }
+
+std::size_t old_txt(const std::string &name, const std::string &txt)
+    {
+    std::sprintf(TxData, "%s.txt=\"%s\"", name.c_str(), txt.c_str());
+    std::string cmd(TxData);
+    return cmd.size();
+    }
+
+// heap calls and bytes per addComp, NB components on 3 pages of d
+void add_all(NDisplay &d, const std::vector<std::string> &names, double &calls,
+        double &bytes)
+    {
+    std::size_t a0 = alloc::calls;
+    std::size_t b0 = alloc::bytes;
+    for (int i = 0; i < NB; ++i)
+        {
+        d.addComp(i / 10 + 1, i % 10 + 1, names[i]);
+        }
+    calls = double(alloc::calls - a0) / NB;
+    bytes = double(alloc::bytes - b0) / NB;
+    }
+}
+
+int main()
+    {
+    display.init(&huart, &hdma);
+    NComp nc = display.addComp(0, 1, "nsat0");
+    // the fake UART keeps what is sent, its buffer made once
+    fake::sent.reserve(1 << 20);
+
+    const std::string NAME {"nsat0"};
+    const std::string VAL_PRE {NAME + ".val="};
+    const std::string TXT_PRE {NAME + ".txt=\""};
+    const std::string TXT {"Sun 18 Oct 2026"};
+
+    NCmd c;
+    CHECK(c.str(VAL_PRE).num(-1234).view() == "nsat0.val=-1234");
+    CHECK(old_val(NAME, -1234) == c.view().size());
+
+    const int N {1000000};
+    volatile std::size_t sink = 0;
+    int v = 0;
+
+    std::size_t a0 = alloc::calls;
+    double tOldVal = ns_per(N, [&]
+        {
+        sink = sink + old_val(NAME, v++);
+        });
+    double tOldTxt = ns_per(N, [&]
+        {
+        sink = sink + old_txt(NAME, TXT);
+        });
+    double aOld = double(alloc::calls - a0) / N / 2;
+
+    a0 = alloc::calls;
+    double tVal = ns_per(N, [&]
+        {
+        NCmd cmd;
+        sink = sink + cmd.str(VAL_PRE).num(v++).view().size();
+        });
+    double tTxt = ns_per(N, [&]
+        {
+        NCmd cmd;
+        sink = sink + cmd.str(TXT_PRE).str(TXT).chr('"').view().size();
+        });
+    CHECK(alloc::calls == a0);
+
+    // new value every time (a repeat is not sent), DMA ends at once
+    double tSet = ns_per(N, [&]
+        {
+        nc.setVal(v++);
+        fake::txBusy = false;
+        display.processTx(&huart);
+        if (fake::sent.size() > (1 << 19))
+            {
+            fake::sent.clear();
+            }
+        });
+    CHECK(alloc::calls == a0);
+    CHECK(display.cmdSent >= (uint32_t) N);
+
+    std::printf("\"nsat0.val=N\":  sprintf + std::string %5.1f ns, NCmd %5.1f ns\n",
+            tOldVal, tVal);
+    std::printf("\"nsat0.txt=..\": sprintf + std::string %5.1f ns, NCmd %5.1f ns\n",
+            tOldTxt, tTxt);
+    std::printf("heap per command: sprintf + std::string %.2f allocations (16+ chars), "
+            "NCmd 0\n", aOld);
+    std::printf("NComp::setVal (format, ring, DMA done): %5.1f ns, 0 allocations\n",
+            tSet);
+
+    // RAM: the display object and the components of main.cpp
+    std::vector<std::string> shortNames(SHORT, SHORT + NB);
+    std::vector<std::string> longNames;
+    for (int i = 0; i < NB; ++i)
+        {
+        longNames.push_back("page1.status_" + std::to_string(i));
+        }
+    double cShort, bShort, cLong, bLong;
+    NDisplay d1;
+    NDisplay d2;
+    add_all(d1, shortNames, cShort, bShort);
+    add_all(d2, longNames, cLong, bLong);
+
+    std::printf("sizeof NObject %zu B, NComp %zu B, NDisplay %zu B\n", sizeof(NObject),
+            sizeof(NComp), sizeof(NDisplay));
+    std::printf("addComp, names of 2..7 chars: %.1f allocations, %.0f B heap each\n",
+            cShort, bShort);
+    std::printf("addComp, names of 14..15 chars: %.1f allocations, %.0f B heap each\n",
+            cLong, bLong);
+
+    return 0;
+    }
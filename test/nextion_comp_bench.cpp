@@ -0,0 +1,155 @@
+/*!
+ * \file nextion_comp_bench.cpp
+ * \brief Nextion component storage: std::map<PnO_Id, NObject> of before against the
+ * dense array of NDisplay (place given by addComp, touch through [page][id]), 30 and
+ * 200 components.
+ *
+ * Lookup of a command (setVal: map find by key against array index) and of a touch
+ * (map find against touchIdx), ns per lookup in a random order; RAM of the storage,
+ * static and heap. Obj has the fields of NObject (its constructors are NDisplay's).
+ */
+
+#include <array>
+#include <cstdio>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+#include "alloc_count.h"
+#include "bench.h"
+#include "hal_fake.h"
+#include "NDisplay.h"
+
+#define CHECK(c) if (!(c)) { std::printf("FAIL line %d: %s\n", __LINE__, #c); return 1; }
+
+namespace
+{
+struct Obj
+    {
+    PnO_Id pNO_id;
+    std::string objname;
+    std::string valPre;
+    std::string txtPre;
+    void (*callbackOnPress)();
+    void (*callbackOnRelease)();
+    };
+static_assert(sizeof(Obj) == sizeof(NObject), "Obj is not NObject");
+
+const int MAX_PAGE {8};
+const int MAX_ID {64};
+
+template<int N>
+struct Dense
+    {
+    std::array<Obj, N> objs;
+    int nb {0};
+    uint8_t touchIdx[MAX_PAGE][MAX_ID] {};
+    };
+
+template<int N>
+int run()
+    {
+    static Dense<N> dense;
+    std::map<PnO_Id, Obj> map;
+    std::vector<PnO_Id> keys;
+    keys.reserve(N);
+
+    // N / 8 components per page, short names as in main.cpp
+    std::size_t b0 = alloc::bytes;
+    std::size_t a0 = alloc::calls;
+    for (int i = 0; i < N; ++i)
+        {
+        PnO_Id key {(uint8_t) (i % MAX_PAGE), (uint8_t) (i / MAX_PAGE + 1)};
+        std::string name = "n" + std::to_string(i);
+        keys.push_back(key);
+        map[key] = Obj {key, name, name + ".val=", name + ".txt=\"", nullptr, nullptr};
+        }
+    double mapHeap = alloc::bytes - b0;
+    double mapCalls = alloc::calls - a0;
+
+    b0 = alloc::bytes;
+    for (int i = 0; i < N; ++i)
+        {
+        std::string name = "n" + std::to_string(i);
+        dense.objs[i] = Obj {keys[i], name, name + ".val=", name + ".txt=\"", nullptr,
+                nullptr};
+        dense.touchIdx[keys[i].first][keys[i].second] = ++dense.nb;
+        }
+    double denseHeap = alloc::bytes - b0;
+
+    // same objects both ways
+    for (int i = 0; i < N; ++i)
+        {
+        CHECK(map.find(keys[i])->second.valPre == dense.objs[i].valPre);
+        const PnO_Id &k = keys[i];
+        CHECK(dense.objs[dense.touchIdx[k.first][k.second] - 1].pNO_id == k);
+        }
+
+    const int M {4096};
+    std::vector<int> order(M);
+    std::mt19937 rng(N);
+    for (int &o : order)
+        {
+        o = rng() % N;
+        }
+
+    const int R {200};
+    volatile std::size_t sink = 0;
+    int j = 0;
+    double tMap = ns_per(R * M, [&]
+        {
+        sink = sink + map.find(keys[order[j++ % M]])->second.valPre.size();
+        });
+    double tIdx = ns_per(R * M, [&]
+        {
+        sink = sink + dense.objs[order[j++ % M]].valPre.size();
+        });
+    double tTouch = ns_per(R * M, [&]
+        {
+        const PnO_Id &k = keys[order[j++ % M]];
+        if (k.first < MAX_PAGE && k.second < MAX_ID)
+            {
+            uint8_t idx = dense.touchIdx[k.first][k.second];
+            if (idx != 0)
+                {
+                sink = sink + dense.objs[idx - 1].pNO_id.second;
+                }
+            }
+        });
+
+    std::printf("%3d components: map find %5.1f ns, array index %4.1f ns, touch table "
+            "%4.1f ns\n", N, tMap, tIdx, tTouch);
+    std::printf("    map: %6zu B static, %6.0f B heap in %3.0f nodes (names in the small"
+            " buffer)\n", sizeof(map), mapHeap, mapCalls);
+    std::printf("  dense: %6zu B static (%zu B touch table), %6.0f B heap\n",
+            sizeof(dense), sizeof(dense.touchIdx), denseHeap);
+
+    return 0;
+    }
+}
+
+int main()
+    {
+    if (run<30>() != 0 || run<200>() != 0)
+        {
+        return 1;
+        }
+
+    // NDisplay keeps MAX_COMP in place: addComp of the same page and id replaces the
+    // object, no heap for short names
+    static NDisplay display;
+    UART_HandleTypeDef huart;
+    DMA_HandleTypeDef hdma;
+    display.init(&huart, &hdma);
+    std::size_t a0 = alloc::calls;
+    NComp a = display.addComp(1, 2, "n0");
+    display.addComp(1, 2, "n1");
+    CHECK(alloc::calls == a0);
+    a.setVal(5);
+    CHECK(fake::sent == std::string("n1.val=5\xff\xff\xff"));
+
+    std::printf("NDisplay: %zu B with the component array, sizeof NObject %zu B\n",
+            sizeof(NDisplay), sizeof(NObject));
+
+    return 0;
+    }
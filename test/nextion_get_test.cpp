@@ -0,0 +1,132 @@
+/*!
+ * \file nextion_get_test.cpp
+ * \brief NDisplay asynchronous get FIFO: answers go to the oldest request, Nextion error
+ * codes fail it at once (no time out, the queue moves on), the start frame
+ * 0x00 0x00 0x00 doesn't, nor does the error of a command sent before the get.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include "hal_fake.h"
+#include "NDisplay.h"
+
+#define CHECK(c) if (!(c)) { std::printf("FAIL line %d: %s\n", __LINE__, #c); return 1; }
+
+namespace
+{
+UART_HandleTypeDef huart;
+DMA_HandleTypeDef hdma;
+NDisplay display;
+
+// all queued commands out
+void drain()
+    {
+    while (fake::txBusy)
+        {
+        fake::txBusy = false;
+        display.processTx(&huart);
+        }
+    }
+
+void receive(const std::string &frame)
+    {
+    std::memcpy(fake::rxBuf, frame.data(), frame.size());
+    display.processRx(&huart, frame.size());
+    display.poll();
+    }
+
+const std::string END {"\xff\xff\xff"};
+
+std::string number(int32_t v)
+    {
+    std::string s {"\x71"};
+    for (int i = 0; i < 4; ++i)
+        {
+        s += (char) (v >> (8 * i));
+        }
+    return s + END;
+    }
+
+int cbCalls {0};
+bool cbOk {true};
+
+void done(void*, bool ok, int32_t, std::string_view)
+    {
+    ++cbCalls;
+    cbOk = ok;
+    }
+}
+
+int main()
+    {
+    NComp n0 = display.addComp(0, 1, "n0");
+    NComp t0 = display.addComp(0, 2, "t0");
+    CHECK(display.init(&huart, &hdma) == HAL_OK);
+
+    NReply r1, r2, r3, r4, r5;
+    CHECK(n0.getValAsync(r1));
+    CHECK(t0.getTextAsync(r2));
+    CHECK(n0.getValAsync(done));
+    CHECK(t0.getTextAsync(r3));
+    drain();
+    CHECK(fake::sent == "get n0.val" + END + "get t0.txt" + END + "get n0.val" + END
+            + "get t0.txt" + END);
+
+    receive(number(-2));
+    CHECK(r1.state == NReply::DONE && r1.val == -2);
+
+    // invalid variable: only this one fails, at once
+    receive("\x1a" + END);
+    CHECK(r2.state == NReply::FAIL);
+    CHECK(cbCalls == 0);
+
+    // invalid operation, for the callback
+    receive("\x1b" + END);
+    CHECK(cbCalls == 1 && !cbOk);
+
+    receive("\x70hello" + END);
+    CHECK(r3.state == NReply::DONE && r3.text() == "hello");
+
+    // Nextion start is not an answer
+    CHECK(n0.getValAsync(r4));
+    drain();
+    receive(std::string("\x00\x00\x00", 3) + END);
+    CHECK(r4.state == NReply::WAIT);
+    receive(number(42));
+    CHECK(r4.state == NReply::DONE && r4.val == 42);
+
+    // every error code frees its place: all places can be used again
+    const char ERR[] {0x00, 0x02, 0x03, 0x04, 0x05, 0x11, 0x1a, 0x1b, 0x1c, 0x1e};
+    for (char e : ERR)
+        {
+        NReply r;
+        CHECK(n0.getValAsync(r));
+        drain();
+        receive(std::string(1, e) + END);
+        CHECK(r.state == NReply::FAIL);
+        }
+
+    // error of a setVal sent before the get: the get still waits for its answer
+    NReply r6;
+    n0.setVal(7);
+    CHECK(t0.getTextAsync(r6));
+    drain();
+    receive("\x1a" + END);
+    CHECK(r6.state == NReply::WAIT && display.cmdErrors == 1);
+    receive("\x70ok" + END);
+    CHECK(r6.state == NReply::DONE && r6.text() == "ok");
+
+    for (int i = 0; i < 8; ++i)
+        {
+        CHECK(n0.getValAsync(done));
+        }
+    CHECK(!n0.getValAsync(r5));
+    CHECK(r5.state == NReply::IDLE);
+
+    CHECK(display.getTimeouts == 0);
+    std::printf("get FIFO: answers, 10 error codes, start frame and error of a setVal OK, "
+            "no time out\n");
+
+    return 0;
+    }
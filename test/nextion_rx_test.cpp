@@ -0,0 +1,104 @@
+/*!
+ * \file nextion_rx_test.cpp
+ * \brief NDisplay receive: frames concatenated in one idle event and cut at any place
+ * (chunks of 1 to 96 bytes) are all found, 0xFF inside number data doesn't end the
+ * frame; then frames per second of the parser are reported.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include "hal_fake.h"
+#include "NDisplay.h"
+
+#define CHECK(c) if (!(c)) { std::printf("FAIL line %d: %s\n", __LINE__, #c); return 1; }
+
+namespace
+{
+UART_HandleTypeDef huart;
+DMA_HandleTypeDef hdma;
+NDisplay display;
+
+int presses {0};
+int releases {0};
+
+void onPress()
+    {
+    ++presses;
+    }
+
+void onRelease()
+    {
+    ++releases;
+    }
+
+// s in idle events of chunk bytes; poll only after every second one, so the
+// interrupt ring holds more than one event sometimes
+void feed(const std::string &s, size_t chunk)
+    {
+    for (size_t i = 0; i < s.size(); i += chunk)
+        {
+        size_t n = std::min(chunk, s.size() - i);
+        std::memcpy(fake::rxBuf, s.data() + i, n);
+        display.processRx(&huart, n);
+        if (n % 2)
+            {
+            display.poll();
+            }
+        }
+    display.poll();
+    }
+}
+
+int main()
+    {
+    display.addComp(0, 12, "b0", onPress, onRelease);
+    CHECK(display.init(&huart, &hdma) == HAL_OK);
+
+    const std::string press("\x65\x00\x0c\x01\xff\xff\xff", 7);
+    const std::string release("\x65\x00\x0c\x00\xff\xff\xff", 7);
+    const std::string number("\x71\xff\xff\xff\xff\xff\xff\xff", 8);
+    const std::string error("\x1a\xff\xff\xff", 4);
+    const std::string burst = press + number + error + release;
+    const int REPEAT {10};
+
+    for (size_t chunk : {1, 2, 3, 5, 7, 13, 26, 29, 96})
+        {
+        presses = releases = 0;
+        uint32_t frames = display.rxFrames;
+        uint32_t dropped = display.rxDropped;
+
+        for (int i = 0; i < REPEAT; ++i)
+            {
+            feed(burst, chunk);
+            }
+
+        CHECK(presses == REPEAT && releases == REPEAT);
+        CHECK(display.rxFrames - frames == 4 * REPEAT);
+        CHECK(display.rxDropped == dropped && display.rxOverrun == 0);
+        }
+    std::printf("4-frame burst in chunks of 1..96 bytes: all frames found, none dropped\n");
+
+    std::string full;
+    while (full.size() + burst.size() <= 96)
+        {
+        full += burst;
+        }
+
+    const int N {200000};
+    uint32_t frames = display.rxFrames;
+    auto t0 = std::chrono::steady_clock::now();
+    for (int i = 0; i < N; ++i)
+        {
+        feed(full, full.size());
+        }
+    std::chrono::duration<double> s = std::chrono::steady_clock::now() - t0;
+    CHECK(display.rxFrames - frames == N * full.size() / burst.size() * 4);
+
+    std::printf("%zu-byte idle events: %.1f M frames/s on this host\n", full.size(),
+            (display.rxFrames - frames) / s.count() / 1e6);
+
+    return 0;
+    }
@@ -0,0 +1,123 @@
+/*!
+ * \file nextion_tx_bench.cpp
+ * \brief Time the main loop is blocked by Nextion commands: DMA ring (this binary)
+ * against blocking HAL_UART_Transmit (nextion_tx_bench_blocking, NXT_TX_BLOCKING).
+ *
+ * The fake UART runs at 230400 baud on the DWT counter, NDisplay measures the wait
+ * itself (txBlockedUs). Ten minutes of page 1 traffic: clock and bars every second,
+ * a few moved sky symbols, the whole sky once a minute (bigger than the ring).
+ * With the ring, a failed DMA start must be retried by flush() and a transfer stopped
+ * by an UART error must go again (txError).
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include "hal_fake.h"
+#include "NDisplay.h"
+
+#define CHECK(c) if (!(c)) { std::printf("FAIL line %d: %s\n", __LINE__, #c); return 1; }
+
+namespace
+{
+NDisplay display;
+UART_HandleTypeDef huart;
+DMA_HandleTypeDef hdma;
+
+void tx_done()
+    {
+    display.processTx(&huart);
+    }
+
+void send(const char *fmt, int a, int b = 0, int c = 0)
+    {
+    char buf[64];
+    int n = std::snprintf(buf, sizeof(buf), fmt, a, b, c);
+    display.sendCommand(std::string_view(buf, n));
+    }
+
+// a symbol: erase old place, circle and number at the new one
+void sky_symbol(int i, int t)
+    {
+    int x = 20 + (i * 37 + t) % 200;
+    int y = 20 + (i * 53 + t) % 200;
+    send("picq %d,%d,31,31,0", x - 15, y - 14);
+    send("cirs %d,%d,14,YELLOW", x, y);
+    send("xstr %d,%d,20,20,4,BLACK,YELLOW,1,1,1,\"%d\"", x - 10, y - 10, i + 1);
+    }
+
+// commands of second t
+void second(int t)
+    {
+    send("ns1.val=%d", t % 10);
+    send("ns2.val=%d", t / 10 % 6);
+    send("nm.val=%d", t / 60 % 60);
+    for (int i = 0; i < 6; ++i)
+        {
+        send("j%d.val=%d", i, 30 + (t + i) % 20);
+        }
+
+    // whole sky after a minute (page switch), else a few symbols moved
+    int nb = t % 60 == 0 ? 40 : 3;
+    for (int i = 0; i < nb; ++i)
+        {
+        sky_symbol(i, t);
+        }
+    }
+}
+
+int main()
+    {
+    fake::baud = 230400;
+    fake::txDone = tx_done;
+    display.init(&huart, &hdma);
+
+    const std::string_view CMD {"t0.txt=\"A\""};
+    const std::string FRAME = std::string(CMD) + "\xff\xff\xff";
+
+#ifndef NXT_TX_BLOCKING
+    // DMA does not start: flush starts it again
+    fake::sent.clear();
+    fake::txFail = true;
+    display.sendCommand(CMD);
+    CHECK(fake::sent.empty());
+    CHECK(display.flush() && fake::sent == FRAME);
+
+    // UART error stops the transfer (HAL ends the DMA): the part goes again
+    fake::sent.clear();
+    display.sendCommand(CMD);
+    fake::txBusy = false;
+    display.txError();
+    CHECK(display.flush() && fake::sent == FRAME + FRAME && display.txErrors == 1);
+    const char *MODE {"DMA ring"};
+#else
+    const char *MODE {"blocking"};
+#endif
+
+    const int T {600};
+    uint32_t maxUs = 0;
+    double sumUs = 0;
+    fake::sent.clear();
+    display.txBlockedUs = 0;
+
+    for (int t = 0; t < T; ++t)
+        {
+        uint32_t t0 = DWT->CYCCNT;
+        second(t);
+        uint32_t us = display.txBlockedUs;
+        display.txBlockedUs = 0;
+        sumUs += us;
+        maxUs = std::max(maxUs, us);
+
+        // rest of the second the loop does other things
+        uint32_t spent = (DWT->CYCCNT - t0) / (SystemCoreClock / 1000000);
+        fake::wait(spent < 1000000 ? 1000000 - spent : 0);
+        }
+    CHECK(display.flush());
+    CHECK(display.txFull == 0);
+
+    std::printf("%-8s: %zu B/s at 230400 baud, blocked %6.2f ms/s mean, %6.2f ms worst "
+            "second\n", MODE, fake::sent.size() / T, sumUs / T / 1e3, maxUs / 1e3);
+
+    return 0;
+    }
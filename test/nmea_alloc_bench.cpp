@@ -0,0 +1,91 @@
+/*!
+ * \file nmea_alloc_bench.cpp
+ * \brief NMEA tokenizing: split() (GPS::parse_sentences before NmeaStream) against
+ * NmeaStream, sentences/s and heap allocations per sentence; then the whole GPS
+ * decode (stream + handlers) must not allocate at all.
+ */
+
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include "alloc_count.h"
+#include "bench.h"
+#include "nmea_old.h"
+#include "GPS.h"
+#include "NmeaStream.h"
+
+#define CHECK(c) if (!(c)) { std::printf("FAIL line %d: %s\n", __LINE__, #c); return 1; }
+
+// main.cpp has it, the sky plot draws on it
+NDisplay display;
+
+namespace
+{
+int accepted;
+int fields;
+
+void count(const NmeaFields &f)
+    {
+    ++accepted;
+    fields += f.size();
+    }
+}
+
+int main()
+    {
+    std::string all;
+    int nb = 0;
+    for (std::string_view s : SECOND)
+        {
+        all += s;
+        ++nb;
+        }
+
+    // same sentences, same fields ('*' split of old GSV gives one more)
+    int oldFields = 0;
+    CHECK(old::tokenize(all, oldFields) == nb);
+    NmeaStream st(count);
+    st.feed((const uint8_t*) all.data(), all.size());
+    CHECK(accepted == nb);
+
+    const int N {100000};
+    volatile int sink = 0;
+
+    std::size_t a0 = alloc::calls;
+    double tOld = ns_per(N, [&]
+        {
+        int f = 0;
+        sink = sink + old::tokenize(all, f);
+        });
+    double aOld = double(alloc::calls - a0) / N / nb;
+
+    a0 = alloc::calls;
+    double tNew = ns_per(N, [&]
+        {
+        st.feed((const uint8_t*) all.data(), all.size());
+        });
+    double aNew = double(alloc::calls - a0) / N / nb;
+    CHECK(aNew == 0);
+
+    // all of GPS decode, one second as in main()
+    a0 = alloc::calls;
+    double tGps = ns_per(N, [&]
+        {
+        GPS::begin_epoch();
+        GPS::stream.feed((const uint8_t*) all.data(), all.size());
+        GPS::read_data();
+        });
+    double aGps = double(alloc::calls - a0) / N / nb;
+    CHECK(aGps == 0);
+    CHECK(GPS::gps_sattNumb == 9 && (GPS::acquired & GPS::ALL_OK) == GPS::ALL_OK);
+
+    std::printf("%d sentences, %zu bytes per second of output\n", nb, all.size());
+    std::printf("split() + cntrCheckSum:  %6.2f M sentences/s, %.1f allocations/sentence\n",
+            nb * 1e3 / tOld, aOld);
+    std::printf("NmeaStream:              %6.2f M sentences/s, %.1f allocations/sentence\n",
+            nb * 1e3 / tNew, aNew);
+    std::printf("GPS decode (+ handlers): %6.2f M sentences/s, %.1f allocations/sentence\n",
+            nb * 1e3 / tGps, aGps);
+
+    return 0;
+    }
@@ -0,0 +1,110 @@
+/*!
+ * \file nmea_checksum_bench.cpp
+ * \brief NMEA checksum: old cntrCheckSum (stoi) against nmea::check, nmea::scan and
+ * NmeaStream (XOR in the copy loop).
+ *
+ * One second of MTK3339 output (datasheet examples), all sentences and one wrong
+ * copy of each must give the same answer, scan() must return the offsets of the good
+ * ones in a packet with broken sentences in between, then all are timed.
+ */
+
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include "NmeaCheck.h"
+#include "NmeaStream.h"
+#include "bench.h"
+#include "nmea_old.h"
+
+#define CHECK(c) if (!(c)) { std::printf("FAIL line %d: %s\n", __LINE__, #c); return 1; }
+
+namespace
+{
+int accepted;
+
+void count(const NmeaFields&)
+    {
+    ++accepted;
+    }
+
+// sentences accepted by the stream
+int stream_ok(NmeaStream &st, std::string_view s)
+    {
+    accepted = 0;
+    st.feed((const uint8_t*) s.data(), s.size());
+    return accepted;
+    }
+}
+
+int main()
+    {
+    NmeaStream st(count);
+    std::string all;
+    std::string mixed;
+    std::string::size_type offs[std::size(SECOND)];
+    int nb = 0;
+
+    for (std::string s : SECOND)
+        {
+        std::string bad = s;
+        bad[7] ^= 1;
+
+        CHECK(old::cntrCheckSum(s) && nmea::check(s) && stream_ok(st, s) == 1);
+        CHECK(!old::cntrCheckSum(bad) && !nmea::check(bad) && stream_ok(st, bad) == 0);
+
+        // good sentence between a wrong one and one cut before '*'
+        mixed += bad;
+        offs[nb] = mixed.size();
+        mixed += s;
+        mixed += s.substr(0, s.find('*'));
+        all += s;
+        ++nb;
+        }
+
+    nmea::Span spans[16];
+    CHECK(nmea::scan(all, spans, 16) == nb);
+    CHECK(nmea::scan(mixed, spans, 16) == nb);
+    for (int i = 0; i < nb; ++i)
+        {
+        std::string_view s(SECOND[i]);
+        CHECK(spans[i].off == offs[i] && spans[i].len == s.find('*') + 3);
+        }
+    CHECK(nmea::scan(all, spans, 3) == 3);
+
+    const int N {200000};
+    volatile int sink = 0;
+
+    double tOld = ns_per(N, [&]
+        {
+        for (std::string_view s : SECOND)
+            {
+            sink = sink + old::cntrCheckSum(s);
+            }
+        });
+
+    double tCheck = ns_per(N, [&]
+        {
+        for (std::string_view s : SECOND)
+            {
+            sink = sink + nmea::check(s);
+            }
+        });
+
+    double tScan = ns_per(N, [&]
+        {
+        sink = sink + nmea::scan(all, spans, 16);
+        });
+
+    double tStream = ns_per(N, [&]
+        {
+        sink = sink + stream_ok(st, all);
+        });
+
+    std::printf("%d sentences, %zu bytes per second of output\n", nb, all.size());
+    std::printf("old cntrCheckSum (stoi):    %7.1f ns/second\n", tOld);
+    std::printf("nmea::check per sentence:   %7.1f ns/second\n", tCheck);
+    std::printf("nmea::scan (offsets):       %7.1f ns/second\n", tScan);
+    std::printf("NmeaStream feed (fields):   %7.1f ns/second\n", tStream);
+
+    return 0;
+    }
@@ -0,0 +1,142 @@
+/*!
+ * \file nmea_old.h
+ * \brief Recorded MTK3339 output and the NMEA code before NmeaStream (split(),
+ * GPS::cntrCheckSum), the "before" of the benchmarks.
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef TEST_NMEA_OLD_H_
+#define TEST_NMEA_OLD_H_
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+// one second of MTK3339 output (datasheet examples)
+inline const char *const SECOND[] {
+        "$GPGGA,064951.000,2307.1256,N,12016.4438,E,1,8,0.95,39.9,M,17.8,M,,*63\r\n",
+        "$GPGSA,A,3,29,21,26,15,18,09,06,10,,,,,2.32,0.95,2.11*00\r\n",
+        "$GPGSV,3,1,09,29,36,029,42,21,46,314,43,26,44,020,43,15,21,321,39*7D\r\n",
+        "$GPGSV,3,2,09,18,26,314,40,09,57,170,44,06,20,229,37,10,26,084,37*77\r\n",
+        "$GPGSV,3,3,09,07,,,26*73\r\n",
+        "$GPRMC,064951.000,A,2307.1256,N,12016.4438,E,0.03,165.48,260406,3.05,W,A*2C\r\n",
+        "$GPVTG,165.48,T,,M,0.03,N,0.06,K,A*36\r\n" };
+
+namespace old
+{
+// GPS::count_check_sum and GPS::cntrCheckSum before the checksum module
+inline int count_check_sum(const std::string_view &s, std::string::size_type &size)
+    {
+    int sum = 0;
+    size = -1;
+    int dollars_nb = 0;
+
+    for (std::string::size_type i = 0; i < s.length(); ++i)
+        {
+        char c = s[i];
+
+        if (c == '$')
+            {
+            if (++dollars_nb > 1)
+                {
+                return -1;
+                }
+            continue;
+            }
+
+        if (dollars_nb == 0)
+            {
+            continue;
+            }
+
+        if (c == '*')
+            {
+            size = i;
+            return sum;
+            }
+
+        sum ^= c;
+        }
+
+    return -1;
+    }
+
+inline bool cntrCheckSum(const std::string_view &s)
+    {
+    std::string::size_type p = 0;
+    int csum = count_check_sum(s, p);
+    if (csum == -1 || s.length() < p + 3)
+        {
+        return false;
+        }
+
+    return csum == std::stoi(std::string(s.substr(p + 1, 2)), 0, 16);
+    }
+
+// MyUtil split() before NmeaFields
+inline std::vector<std::string_view> split(std::string_view buffer,
+        const std::string_view delimiter)
+    {
+    std::vector<std::string_view> result;
+    std::string_view::size_type pos;
+
+    while ((pos = buffer.find(delimiter)) != std::string_view::npos)
+        {
+        auto match = buffer.substr(0, pos);
+
+        if (match.empty() && (delimiter == "," || delimiter == "*"))
+            {
+            // null (empty field best be expressed as zero
+            result.push_back("0");
+            }
+
+        if (!match.empty())
+            {
+            result.push_back(match);
+            }
+
+        buffer.remove_prefix(pos + delimiter.size());
+        }
+
+    if (!buffer.empty() && delimiter != "*")
+        {
+        result.push_back(buffer);
+        }
+
+    return result;
+    }
+
+/*!
+ * \brief GPS::parse_sentences up to the fields: packet split in sentences, checksum,
+ * fields, and the '*' split of the last GSV field
+ *
+ * \return sentences with right checksum; fields counts all fields
+ */
+inline int tokenize(std::string_view packet, int &fields)
+    {
+    int nb = 0;
+    auto lines = split(packet, "\r\n");
+
+    for (auto line : lines)
+        {
+        if (!cntrCheckSum(line))
+            {
+            continue;
+            }
+
+        auto f = split(line, ",");
+        if (f[0] == "$GPGSV")
+            {
+            auto last = split(f.back(), "*");
+            fields += last.size();
+            }
+        fields += f.size();
+        ++nb;
+        }
+
+    return nb;
+    }
+}
+
+#endif /* TEST_NMEA_OLD_H_ */
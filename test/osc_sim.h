@@ -0,0 +1,47 @@
+/*!
+ * \file osc_sim.h
+ * \brief Simulated TIM2 against GPS PPS for the servo tests (timer ticks).
+ *
+ * F ticks of the timer in one second (less 1, as ARR) with aging and random walk,
+ * PPS seen with white phase noise; the timer counts ARR u of the servo:
+ * x(k+1) = x(k) + F - u(k), as in ClockServo.
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef TEST_OSC_SIM_H_
+#define TEST_OSC_SIM_H_
+
+#include <cmath>
+#include <random>
+
+// nominal ARR, TIM2 at 90 MHz + 3938 Hz
+const int ARR0 {90003938 - 1};
+
+struct OscSim
+    {
+    // true frequency and phase
+    double F;
+    double x {0};
+    // aging [ticks/s^2], random walk [ticks/s per sqrt(s)], PPS noise [ticks]
+    double aging;
+    double rw;
+    double wp;
+    std::mt19937 gen;
+    std::normal_distribution<double> norm {0, 1};
+
+    OscSim(double f, double _aging, double _rw, double _wp, unsigned seed) :
+            F(f), aging(_aging), rw(_rw), wp(_wp), gen(seed)
+        {
+        }
+
+    // one second with ARR u, PPS phase measured at its end
+    int step(int u)
+        {
+        F += aging + rw * norm(gen);
+        x += F - u;
+        return (int) std::lround(x + wp * norm(gen));
+        }
+    };
+
+#endif /* TEST_OSC_SIM_H_ */
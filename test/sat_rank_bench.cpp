@@ -0,0 +1,166 @@
+/*!
+ * \file sat_rank_bench.cpp
+ * \brief Ranking by SNR: old update_strong() (vector of all satellites, std::sort
+ * after the burst), SatRank updated for every satellite while GSV is decoded plus the
+ * counting sort of the sky z-order (SVs::sort_z), and GPS::update_strong() which
+ * takes the bars from the head of the z-order.
+ *
+ * 12 (GP) and 40 (GP/GL/GA/GB) SVs. The N strongest and the z-order must be the
+ * SNR order, same SNR lower key first.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+#include "bench.h"
+#include "gnss_burst.h"
+#include "GPS.h"
+#include "GPSsat.h"
+
+#define CHECK(c) if (!(c)) { std::printf("FAIL line %d: %s\n", __LINE__, #c); return 1; }
+
+// main.cpp has it, the sky plot draws on it
+NDisplay display;
+
+namespace
+{
+std::vector<GPSsat> epoch(int systems, int perSys, int t)
+    {
+    std::vector<GPSsat> sats;
+
+    for (int sys = 0; sys < systems; ++sys)
+        {
+        for (const auto &sv : burst::sky(sys, perSys, t))
+            {
+            gnss::Sys s = (gnss::Sys) sys;
+            int prn = gnss::norm_prn(s, sv.prn);
+            sats.push_back(GPSsat(prn, sv.el, sv.az, sv.snr, s));
+            }
+        }
+
+    return sats;
+    }
+
+void fill(const std::vector<GPSsat> &sats)
+    {
+    SVs::new_spaceVehicles.clear();
+    for (const auto &s : sats)
+        {
+        SVs::new_spaceVehicles.insert(s.key(), s);
+        }
+    }
+
+// GPS::update_strong before SatRank
+std::vector<Strong> oldStrong;
+
+void old_rank(const SVs::SatSet &svs)
+    {
+    oldStrong.clear();
+    for (int k : svs)
+        {
+        oldStrong.push_back( {k, svs[k].id, svs[k].SNR});
+        }
+
+    // strongest satellite first
+    std::sort(std::begin(oldStrong), std::end(oldStrong), [](Strong a, Strong b)
+        {
+            return a.snr > b.snr;
+        });
+    }
+
+// SatRank per satellite in parse_gsv, z-order at the end
+void gsv_rank(const std::vector<GPSsat> &sats)
+    {
+    SVs::new_spaceVehicles.clear();
+    SVs::strongest_sats.clear();
+    for (const auto &s : sats)
+        {
+        SVs::new_spaceVehicles.insert(s.key(), s);
+        SVs::strongest_sats.update( {s.key(), s.id, s.SNR});
+        }
+    SVs::sort_z();
+    }
+
+// parse_gsv and read_data now
+void new_rank(const std::vector<GPSsat> &sats)
+    {
+    fill(sats);
+    GPS::update_strong();
+    }
+}
+
+int main()
+    {
+    const int T {64};
+
+    for (int systems : {1, 4})
+        {
+        int perSys = systems == 1 ? 12 : 10;
+        std::vector<std::vector<GPSsat>> secs;
+        for (int t = 0; t < T; ++t)
+            {
+            secs.push_back(epoch(systems, perSys, t * 60));
+            }
+
+        for (const auto &sats : secs)
+            {
+            std::vector<Strong> ref;
+            for (const auto &s : sats)
+                {
+                ref.push_back( {s.key(), s.id, s.SNR});
+                }
+            std::sort(ref.begin(), ref.end(), [](Strong a, Strong b)
+                {
+                    return a.before(b);
+                });
+
+            gsv_rank(sats);
+            int top = std::min<int>(SVs::NB_STRONG, sats.size());
+            CHECK(SVs::strongest_sats.size() == top);
+            for (int i = 0; i < top; ++i)
+                {
+                CHECK(SVs::strongest_sats[i].key == ref[i].key);
+                }
+
+            new_rank(sats);
+            CHECK(SVs::z_nb == (int) sats.size());
+            for (int i = 0; i < SVs::z_nb; ++i)
+                {
+                CHECK(SVs::z_order[i] == ref[i].key);
+                }
+            CHECK(SVs::strongest_sats.size() == top);
+            for (int i = 0; i < top; ++i)
+                {
+                CHECK(SVs::strongest_sats[i].key == ref[i].key);
+                }
+            }
+
+        const int N {50000};
+        int t = 0;
+
+        // old: the table is already filled by the decode, only the ranking is timed
+        double tFill = ns_per(N, [&]
+            {
+            fill(secs[t++ % T]);
+            });
+        double tOld = ns_per(N, [&]
+            {
+            fill(secs[t++ % T]);
+            old_rank(SVs::new_spaceVehicles);
+            }) - tFill;
+        double tGsv = ns_per(N, [&]
+            {
+            gsv_rank(secs[t++ % T]);
+            }) - tFill;
+        double tNew = ns_per(N, [&]
+            {
+            new_rank(secs[t++ % T]);
+            }) - tFill;
+
+        std::printf("%2zu SVs: old vector + std::sort %4.0f ns/epoch | SatRank per GSV "
+                "satellite + sort_z %4.0f | sort_z + head %4.0f\n", secs[0].size(), tOld,
+                tGsv, tNew);
+        }
+
+    return 0;
+    }
@@ -0,0 +1,152 @@
+/*!
+ * \file sat_table_bench.cpp
+ * \brief Satellite set of one second: SatTable against the std::map it replaced.
+ *
+ * One epoch as GPS decode and the sky plot do it: clear the new set, insert the
+ * satellites of the GSV burst, look every new one up in the old set and every old
+ * one up in the new set, then old = new. 16..40 SVs over GP/GL/GA/GB; both must give
+ * the same keys in the same order. Heap of the map is counted, the table has none.
+ */
+
+#include <cstdio>
+#include <map>
+#include <vector>
+#include "alloc_count.h"
+#include "bench.h"
+#include "gnss_burst.h"
+#include "GPSsat.h"
+
+#define CHECK(c) if (!(c)) { std::printf("FAIL line %d: %s\n", __LINE__, #c); return 1; }
+
+// main.cpp has it, the sky plot draws on it
+NDisplay display;
+
+namespace
+{
+typedef std::map<int, GPSsat> SatMap;
+
+// satellites of second t, nb over 4 systems
+std::vector<GPSsat> epoch(int nb, int t)
+    {
+    std::vector<GPSsat> sats;
+
+    for (int sys = 0; sys < 4; ++sys)
+        {
+        for (const auto &sv : burst::sky(sys, nb / 4 + (sys < nb % 4), t))
+            {
+            gnss::Sys s = (gnss::Sys) sys;
+            int prn = gnss::norm_prn(s, sv.prn);
+            sats.push_back(GPSsat(prn, sv.el, sv.az, sv.snr, s));
+            }
+        }
+
+    return sats;
+    }
+
+// keys that moved or went, summed so nothing is optimized away
+int step(SatMap &olds, SatMap &news, const std::vector<GPSsat> &sats)
+    {
+    int changed = 0;
+
+    news.clear();
+    for (const auto &s : sats)
+        {
+        news.insert_or_assign(s.key(), s);
+        }
+    for (const auto &[k, s] : news)
+        {
+        auto it = olds.find(k);
+        changed += it == olds.end() || it->second.is_moved(s);
+        }
+    for (const auto &[k, s] : olds)
+        {
+        changed += news.find(k) == news.end();
+        }
+    olds = news;
+
+    return changed;
+    }
+
+int step(SVs::SatSet &olds, SVs::SatSet &news, const std::vector<GPSsat> &sats)
+    {
+    int changed = 0;
+
+    news.clear();
+    for (const auto &s : sats)
+        {
+        news.insert(s.key(), s);
+        }
+    for (int k : news)
+        {
+        changed += !olds.contains(k) || olds[k].is_moved(news[k]);
+        }
+    for (int k : olds)
+        {
+        changed += !news.contains(k);
+        }
+    olds.clear();
+    for (int k : news)
+        {
+        olds.insert(k, news[k]);
+        }
+
+    return changed;
+    }
+}
+
+int main()
+    {
+    static SVs::SatSet tOld, tNew;
+    const int T {64};
+
+    std::printf("SatTable: %zu bytes static per set, no heap\n", sizeof(SVs::SatSet));
+
+    for (int nb : {16, 24, 32, 40})
+        {
+        std::vector<std::vector<GPSsat>> secs;
+        for (int t = 0; t < T; ++t)
+            {
+            secs.push_back(epoch(nb, t * 60));
+            }
+
+        SatMap mOld, mNew;
+        tOld.clear();
+        for (int t = 0; t < T; ++t)
+            {
+            CHECK(step(mOld, mNew, secs[t]) == step(tOld, tNew, secs[t]));
+            }
+        CHECK((int) mNew.size() == nb && tNew.size() == nb);
+        auto it = mNew.begin();
+        for (int k : tNew)
+            {
+            CHECK(k == it->first);
+            ++it;
+            }
+
+        const int N {20000};
+        volatile int sink = 0;
+        int t = 0;
+
+        std::size_t a0 = alloc::calls;
+        std::size_t b0 = alloc::bytes;
+        double tMap = ns_per(N, [&]
+            {
+            sink = sink + step(mOld, mNew, secs[t++ % T]);
+            });
+        double aMap = double(alloc::calls - a0) / N;
+        double bMap = double(alloc::bytes - b0) / aMap / N;
+
+        a0 = alloc::calls;
+        double tTab = ns_per(N, [&]
+            {
+            sink = sink + step(tOld, tNew, secs[t++ % T]);
+            });
+        CHECK(alloc::calls == a0);
+
+        std::printf("%2d SVs: map %6.0f ns/epoch, %5.1f allocations/epoch (%.0f bytes each),"
+                " %zu bytes of nodes per set | SatTable %5.0f ns/epoch\n", nb, tMap, aMap,
+                bMap, (std::size_t) (nb * bMap), tTab);
+        }
+
+    return 0;
+    }
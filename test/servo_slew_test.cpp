@@ -0,0 +1,168 @@
+/*!
+ * \file servo_slew_test.cpp
+ * \brief ClockServo output: sigma-delta ARR when locked, 1 h holdover drift, and a
+ * 5 ms phase step slewed out (Kalman and PI).
+ *
+ * Oscillator F = ARR0 + 150.37 (fraction for the dither), 1 day locked first. The step
+ * must not move ARR more than slew from the frequency held before it, and the
+ * frequency must come back unchanged.
+ *
+ * Against the same servo with ARR only rounded and no slew limit (setDither(false),
+ * setSlew(1e9)): lower phase RMS, no phase jump at the step, and a lower 10 s frequency
+ * error over lock and holdover (PI; Kalman's model phase already carries the rounding).
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include "ClockServo.h"
+#include "osc_sim.h"
+
+#define CHECK(c) if (!(c)) { std::printf("FAIL line %d: %s\n", __LINE__, #c); return 1; }
+
+namespace
+{
+const double F0 {ARR0 + 150.37};
+const double SLEW {2000};
+// 5 ms at 90 MHz
+const double STEP {450000};
+
+struct Result
+    {
+    double rms;
+    // RMS of the frequency error averaged over 10 s, locked and holdover [ticks/s]
+    double f10;
+    double drift;
+    // max |ARR - frequency before the step|, max ARR change in one second
+    double maxDev;
+    int maxChange;
+    // seconds to |phase| < 20 ticks, largest overshoot after it, frequency error at end
+    int back;
+    double over;
+    double fErr;
+    };
+
+// shaped: dither and slew limit, else ARR rounded and the phase steered out at once
+Result run(ClockServo::Mode mode, double wp, double rw, bool shaped = true)
+    {
+    OscSim osc(F0, 0, rw, wp, 5);
+    ClockServo servo(ARR0, mode);
+    servo.setSlew(shaped ? SLEW : 1e9);
+    servo.setDither(shaped);
+    int u = ARR0;
+    Result res {};
+
+    for (int k = 0; k < 86400; ++k)
+        {
+        u = servo.update(osc.step(u));
+        }
+
+    // 10 s frequency error over the locked hour and the holdover hour
+    double x10 = osc.x;
+    auto window = [&](int k)
+        {
+            if (k % 10 == 0)
+                {
+                double df = (osc.x - x10) / 10;
+                res.f10 += df * df / 720;
+                x10 = osc.x;
+                }
+        };
+
+    for (int k = 1; k <= 3600; ++k)
+        {
+        u = servo.update(osc.step(u));
+        res.rms += osc.x * osc.x / 3600;
+        window(k);
+        }
+    res.rms = std::sqrt(res.rms);
+
+    double x0 = osc.x;
+    for (int k = 1; k <= 3600; ++k)
+        {
+        osc.step(u);
+        u = servo.hold();
+        window(k);
+        }
+    res.f10 = std::sqrt(res.f10);
+    res.drift = (osc.x - x0) / 3600;
+
+    // back locked, then the step
+    for (int k = 0; k < 600; ++k)
+        {
+        u = servo.update(osc.step(u));
+        }
+    double fHeld = servo.freq();
+    osc.x += STEP;
+    res.back = -1;
+    int prev = u;
+    for (int k = 0; k < 3000; ++k)
+        {
+        u = servo.update(osc.step(u));
+        res.maxDev = std::max(res.maxDev, std::fabs(u - fHeld));
+        res.maxChange = std::max(res.maxChange, std::abs(u - prev));
+        prev = u;
+        if (res.back < 0 && std::fabs(osc.x) < 20)
+            {
+            res.back = k;
+            }
+        if (res.back >= 0)
+            {
+            res.over = std::max(res.over, -osc.x);
+            }
+        }
+    res.fErr = servo.freq() - osc.F;
+
+    return res;
+    }
+}
+
+int main()
+    {
+    for (ClockServo::Mode mode : {ClockServo::KALMAN, ClockServo::PI})
+        {
+        for (double wp : {0.0, 4.5})
+            {
+            for (double rw : {0.0, 0.005})
+                {
+                Result r = run(mode, wp, rw);
+                Result b = run(mode, wp, rw, false);
+                const char *name = mode == ClockServo::PI ? "PI" : "Kalman";
+                std::printf("%-6s wp %.1f rw %5.3f: locked rms %.2f, 1 h hold %+.3f "
+                        "tick/s\n    5 ms step: ARR within %.0f of F, change %d/s, back "
+                        "in %d s, overshoot %.0f, F error %+.2f\n", name, wp, rw, r.rms,
+                        r.drift, r.maxDev, r.maxChange, r.back, r.over, r.fErr);
+                std::printf("    rounded ARR, no slew: locked rms %.2f, 1 h hold %+.3f "
+                        "tick/s, step change %d/s | 10 s frequency RMS %.3f tick/s, "
+                        "rounded %.3f\n", b.rms, b.drift, b.maxChange, r.f10, b.f10);
+
+                // dithered ARR: 0.3 of a tick, rounded ARR gives ~0.5
+                if (wp == 0 && rw == 0)
+                    {
+                    CHECK(r.rms < 0.4 && b.rms > 0.5);
+                    }
+                // no jump of the phase: ARR moves by the slew at most
+                CHECK(r.maxChange <= SLEW + 1 && b.maxChange > 10 * SLEW);
+                // PI runs on the rounded frequency in holdover, Kalman steers its model
+                // phase (the rounding of it too, like a slow sigma-delta)
+                if (mode == ClockServo::PI)
+                    {
+                    CHECK(r.f10 < 0.7 * b.f10);
+                    }
+                else
+                    {
+                    CHECK(r.f10 < 1.1 * b.f10);
+                    }
+                CHECK(std::fabs(r.drift) < 0.05);
+                // slew plus the noise of the frequency estimate
+                CHECK(r.maxDev < SLEW + 25);
+                // slew time and the tail of the loop (PI tau 10 s)
+                CHECK(r.back > 0 && r.back < STEP / SLEW + 100);
+                CHECK(std::fabs(r.fErr) < 1);
+                }
+            }
+        }
+
+    return 0;
+    }
@@ -0,0 +1,208 @@
+/*!
+ * \file sky_bytes_bench.cpp
+ * \brief Sky plot traffic to Nextion over 24 h: per-satellite erase (update_sats
+ * before the compositor) against SkyComp::compose (merged erase rectangles).
+ *
+ * No recording of a real sky is at hand, so 24 h of GP/GL/GA/GB constellations are
+ * synthesized: satellites rise, move and set, SNR follows the elevation. Every second
+ * goes through the flags of show_satellites (main.cpp) and then one of the two
+ * repaints; the bytes which reach the fake UART are counted. NDisplay is built with
+ * NXT_TX_BLOCKING, so the UART never fills.
+ */
+
+#include <cmath>
+#include <cstdio>
+#include "hal_fake.h"
+#include "GPSsat.h"
+
+#define CHECK(c) if (!(c)) { std::printf("FAIL line %d: %s\n", __LINE__, #c); return 1; }
+
+NDisplay display;
+
+namespace
+{
+// per system, the receiver sees the ones above the horizon
+const int CONST_NB {24};
+const int DAY {86400};
+// 230400 baud, 8N1
+const double LINK_BPS {23040};
+
+// sky of second t into new_spaceVehicles
+void sky(int t)
+    {
+    SVs::new_spaceVehicles.clear();
+
+    for (int sys = 0; sys < 4; ++sys)
+        {
+        // GPS and BeiDou MEO half a sidereal day, GLONASS 11.3 h, Galileo 14.1 h
+        static const double PERIOD[] {43082, 40544, 50680, 46404};
+
+        for (int i = 0; i < CONST_NB; ++i)
+            {
+            double ph = 2 * M_PI
+                    * (t / PERIOD[sys] + i / double(CONST_NB) + sys * 0.17);
+            // some passes go high, some stay low
+            double top = 40 + 50 * std::fabs(std::sin(i * 1.7 + sys));
+            int el = std::lround(top * std::sin(ph) - 15);
+            if (el < 5)
+                {
+                continue;
+                }
+
+            int az = std::lround(i * 15 + sys * 40 + ph * 57.3 / 2) % 360;
+            long snr = std::lround(18 + el / 3.0 + 3 * std::sin(t / 97.0 + i));
+            snr = std::min(snr, 50L);
+            GPSsat sat(i + 1, std::min(el, 90), az, snr, sys);
+            SVs::new_spaceVehicles.insert(sat.key(), sat);
+            }
+        }
+
+    SVs::sort_z();
+    }
+
+// sat::show_satellites without the display of the count
+void flags()
+    {
+    for (int id : SVs::old_spaceVehicles)
+        {
+        SVs::old_spaceVehicles[id].flag = 0;
+        }
+
+    for (int id : SVs::new_spaceVehicles)
+        {
+        const GPSsat &s_new = SVs::new_spaceVehicles[id];
+        if (SVs::old_spaceVehicles.contains(id))
+            {
+            if (s_new == SVs::old_spaceVehicles[id])
+                {
+                continue;
+                }
+
+            SVs::old_spaceVehicles[id].flag =
+                    s_new.is_moved(SVs::old_spaceVehicles[id]) ? GPSsat::PE : GPSsat::P;
+            }
+        else
+            {
+            SVs::old_spaceVehicles.insert(id, s_new);
+            SVs::old_spaceVehicles[id].flag = GPSsat::P;
+            }
+        }
+    }
+
+// SVs::update_sats before SkyComp: one picq per erased symbol, neighbours of the
+// erased ones repainted
+void old_update()
+    {
+    auto &olds = SVs::old_spaceVehicles;
+    auto &news = SVs::new_spaceVehicles;
+
+    for (int k : olds)
+        {
+        if (!news.contains(k))
+            {
+            olds[k].flag = GPSsat::E;
+            }
+        }
+
+    for (int k : olds)
+        {
+        if (olds[k].has2clear())
+            {
+            for (int n : news)
+                {
+                if (SVs::dist(olds[k], news[n]) < SVs::WCLR)
+                    {
+                    olds[n].flag |= GPSsat::P;
+                    }
+                }
+            }
+        }
+
+    for (int i = SVs::z_nb - 1; i >= 0; --i)
+        {
+        if (olds[SVs::z_order[i]].has2paint())
+            {
+            SVs::near_stronger(i, [&olds](int n)
+                {
+                olds[n].flag |= GPSsat::P;
+                });
+            }
+        }
+
+    for (int k : olds)
+        {
+        if (olds[k].has2clear())
+            {
+            SVs::erase_sat(olds[k]);
+            }
+
+        if (!news.contains(k))
+            {
+            olds.erase(k);
+            }
+        }
+
+    for (int i = SVs::z_nb - 1; i >= 0; --i)
+        {
+        int k = SVs::z_order[i];
+        if (olds[k].has2paint())
+            {
+            SVs::draw_sat(news[k]);
+            }
+
+        olds[k] = news[k];
+        }
+    }
+
+struct Day
+    {
+    double bytes {0};
+    double cmds {0};
+    uint32_t maxFrame {0};
+    int inView {0};
+    };
+
+template<typename F>
+Day replay(F update)
+    {
+    Day d;
+    SVs::old_spaceVehicles.clear();
+
+    for (int t = 0; t < DAY; ++t)
+        {
+        sky(t);
+        flags();
+        fake::sent.clear();
+        SkyComp::frame_bytes = 0;
+        SkyComp::frame_cmds = 0;
+        update();
+
+        d.bytes += fake::sent.size();
+        d.cmds += SkyComp::frame_cmds;
+        d.maxFrame = std::max<uint32_t>(d.maxFrame, fake::sent.size());
+        d.inView = std::max(d.inView, SVs::new_spaceVehicles.size());
+        }
+
+    return d;
+    }
+}
+
+int main()
+    {
+    Day before = replay(old_update);
+    Day after = replay(SVs::update_sats);
+
+    // bytes counted by SkyComp are the bytes on the line
+    CHECK(SkyComp::frame_bytes == fake::sent.size());
+    CHECK(after.bytes <= before.bytes);
+
+    std::printf("24 h, up to %d SVs in view\n", after.inView);
+    std::printf("per-symbol erase:  %6.1f B/s (%4.1f%% of the link), %5.2f cmd/s, max "
+            "frame %4u B\n", before.bytes / DAY, 100 * before.bytes / DAY / LINK_BPS,
+            before.cmds / DAY, before.maxFrame);
+    std::printf("SkyComp::compose:  %6.1f B/s (%4.1f%% of the link), %5.2f cmd/s, max "
+            "frame %4u B\n", after.bytes / DAY, 100 * after.bytes / DAY / LINK_BPS,
+            after.cmds / DAY, after.maxFrame);
+
+    return 0;
+    }
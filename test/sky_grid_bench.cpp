@@ -0,0 +1,185 @@
+/*!
+ * \file sky_grid_bench.cpp
+ * \brief Sky plot repaint: neighbours found through a uniform grid (the SVs::near
+ * of before) against every stronger satellite (SVs::near_stronger), 10..60 satellites.
+ *
+ * Step of SkyComp::compose which makes stronger neighbours of a repainted symbol
+ * repainted, walked from the weakest up. Some satellites start as repainted (moved);
+ * both ways must end with the same set.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+#include "bench.h"
+#include "gnss_burst.h"
+#include "GPSsat.h"
+
+#define CHECK(c) if (!(c)) { std::printf("FAIL line %d: %s\n", __LINE__, #c); return 1; }
+
+// main.cpp has it, the sky plot draws on it
+NDisplay display;
+
+namespace
+{
+bool paint[gnss::SAT_NB];
+
+// 8 x 8 cells of WCLR over the plot (240 x 240), symbols closer than WCLR are in the
+// same or a neighbouring cell
+const int GRID_W {8};
+int16_t grid_head[GRID_W * GRID_W];
+int16_t grid_next[gnss::SAT_NB];
+// place in z_order of a key
+int16_t z_rank[gnss::SAT_NB];
+
+int cell(int c)
+    {
+    return std::clamp(c / SVs::WCLR, 0, GRID_W - 1);
+    }
+
+void grid_build()
+    {
+    std::fill(std::begin(grid_head), std::end(grid_head), -1);
+
+    for (int k : SVs::new_spaceVehicles)
+        {
+        const GPSsat &s = SVs::new_spaceVehicles[k];
+        int c = cell(s.yo) * GRID_W + cell(s.xo);
+        grid_next[k] = grid_head[c];
+        grid_head[c] = k;
+        }
+    }
+
+template<typename F>
+void near(const GPSsat &s, F f)
+    {
+    int cx = cell(s.xo);
+    int cy = cell(s.yo);
+
+    for (int y = std::max(cy - 1, 0); y <= std::min(cy + 1, GRID_W - 1); ++y)
+        {
+        for (int x = std::max(cx - 1, 0); x <= std::min(cx + 1, GRID_W - 1); ++x)
+            {
+            for (int k = grid_head[y * GRID_W + x]; k >= 0; k = grid_next[k])
+                {
+                if (SVs::dist(s, SVs::new_spaceVehicles[k]) < SVs::WCLR)
+                    {
+                    f(k);
+                    }
+                }
+            }
+        }
+    }
+
+// every 4th satellite moved, sky in new_spaceVehicles, z-order made
+void start()
+    {
+    int n = 0;
+    for (int k : SVs::new_spaceVehicles)
+        {
+        paint[k] = n++ % 4 == 0;
+        }
+    }
+
+int grid()
+    {
+    grid_build();
+    for (int i = 0; i < SVs::z_nb; ++i)
+        {
+        z_rank[SVs::z_order[i]] = i;
+        }
+
+    int nb = 0;
+    for (int i = SVs::z_nb - 1; i >= 0; --i)
+        {
+        int k = SVs::z_order[i];
+        if (paint[k])
+            {
+            ++nb;
+            near(SVs::new_spaceVehicles[k], [i](int n)
+                {
+                if (z_rank[n] < i)
+                    {
+                    paint[n] = true;
+                    }
+                });
+            }
+        }
+
+    return nb;
+    }
+
+// as compose does it now
+int pairs()
+    {
+    int nb = 0;
+
+    for (int i = SVs::z_nb - 1; i >= 0; --i)
+        {
+        if (paint[SVs::z_order[i]])
+            {
+            ++nb;
+            SVs::near_stronger(i, [](int n)
+                {
+                paint[n] = true;
+                });
+            }
+        }
+
+    return nb;
+    }
+}
+
+int main()
+    {
+    for (int nb : {10, 20, 30, 40, 50, 60})
+        {
+        const int T {32};
+        double tGrid = 0;
+        double tPairs = 0;
+        int repaint = 0;
+
+        for (int t = 0; t < T; ++t)
+            {
+            SVs::new_spaceVehicles.clear();
+            for (int sys = 0; sys < 4; ++sys)
+                {
+                for (const auto &sv : burst::sky(sys, nb / 4 + (sys < nb % 4), t * 600))
+                    {
+                    gnss::Sys s = (gnss::Sys) sys;
+                    int prn = gnss::norm_prn(s, sv.prn);
+                    GPSsat sat(prn, sv.el, sv.az, sv.snr, s);
+                    SVs::new_spaceVehicles.insert(sat.key(), sat);
+                    }
+                }
+            SVs::sort_z();
+
+            start();
+            int g = grid();
+            bool byGrid[gnss::SAT_NB];
+            std::copy(std::begin(paint), std::end(paint), byGrid);
+            start();
+            CHECK(pairs() == g);
+            CHECK(std::equal(std::begin(paint), std::end(paint), byGrid));
+            repaint += g;
+
+            const int N {2000};
+            volatile int sink = 0;
+            tGrid += ns_per(N, [&]
+                {
+                start();
+                sink = sink + grid();
+                });
+            tPairs += ns_per(N, [&]
+                {
+                start();
+                sink = sink + pairs();
+                });
+            }
+
+        std::printf("%2d SVs (%4.1f repainted): pairs %6.0f ns, grid %6.0f ns (incl. "
+                "build)\n", nb, double(repaint) / T, tPairs / T, tGrid / T);
+        }
+
+    return 0;
+    }
@@ -0,0 +1,108 @@
+/*!
+ * \file sky_lut_test.cpp
+ * \brief sky::x/y (SkyLut.h) for all 91 x 360 inputs: against the exactly rounded
+ * real value (must be equal) and the old float GPSsat::xy_c (reported), then timed.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include "SkyLut.h"
+
+namespace
+{
+const float D2R {3.14159265358979f / 180.0f};
+
+// GPSsat::xy_c before the tables
+void xy_float(int alt, int azim, int &xo, int &yo)
+    {
+    float r = sky::R * (1 - (float) alt / 90.0);
+    xo = (int) std::round(r * sinf(D2R * azim) + sky::X0);
+    yo = (int) std::round(sky::Y0 - r * cosf(D2R * azim));
+    }
+
+// round half up; exact .5 (sin 30 deg and alike) comes out of sin() as .49999.., so
+// a value that close to .5 is taken as the tie it really is
+int round_ref(long double v)
+    {
+    long double f = std::floor(v);
+    return (int) f + (v - f > 0.5L - 1e-9L ? 1 : 0);
+    }
+
+// reference in long double
+void xy_exact(int alt, int azim, int &xo, int &yo)
+    {
+    const long double PI {3.141592653589793238462643383279L};
+    long double r = sky::R * (90 - alt) / 90.0L;
+    long double a = azim * PI / 180;
+    xo = round_ref(sky::X0 + r * std::sin(a));
+    yo = round_ref(sky::Y0 - r * std::cos(a));
+    }
+
+template<typename F>
+double ns_per_point(F f)
+    {
+    const int REP {200};
+    auto t0 = std::chrono::steady_clock::now();
+    for (int k = 0; k < REP; ++k)
+        {
+        for (int el = 0; el <= 90; ++el)
+            {
+            for (int az = 0; az < 360; ++az)
+                {
+                f(el, az);
+                }
+            }
+        }
+    std::chrono::duration<double, std::nano> d = std::chrono::steady_clock::now() - t0;
+    return d.count() / (REP * 91 * 360);
+    }
+}
+
+int main()
+    {
+    int wrong = 0;
+    int floatDiff = 0;
+
+    for (int el = 0; el <= 90; ++el)
+        {
+        for (int az = 0; az < 360; ++az)
+            {
+            int xe, ye, xf, yf;
+            xy_exact(el, az, xe, ye);
+            xy_float(el, az, xf, yf);
+
+            if (sky::x(el, az) != xe || sky::y(el, az) != ye)
+                {
+                std::printf("FAIL el %d az %d: table %d,%d exact %d,%d\n", el, az,
+                        sky::x(el, az), sky::y(el, az), xe, ye);
+                ++wrong;
+                }
+
+            if (xf != xe || yf != ye)
+                {
+                std::printf("float differs el %d az %d: float %d,%d exact %d,%d\n", el,
+                        az, xf, yf, xe, ye);
+                ++floatDiff;
+                }
+            }
+        }
+
+    volatile int sink = 0;
+    double tFloat = ns_per_point([&](int el, int az)
+        {
+        int x, y;
+        xy_float(el, az, x, y);
+        sink = sink + x + y;
+        });
+    double tLut = ns_per_point([&](int el, int az)
+        {
+        sink = sink + sky::x(el, az) + sky::y(el, az);
+        });
+
+    std::printf("91 x 360 points: table wrong %d, old float differs %d\n", wrong,
+            floatDiff);
+    std::printf("float %.2f ns/point, table %.2f ns/point\n", tFloat, tLut);
+
+    return wrong == 0 ? 0 : 1;
+    }
@@ -0,0 +1,161 @@
+/*!
+ * \file stability_test.cpp
+ * \brief Stability (streaming ADEV/MDEV) against a batch computation of the same
+ * non overlapped estimators on 2^17 s of white phase + random walk frequency, a gap,
+ * and the servo tuned from the measured noises as tune_servo() in main.cpp does.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "ClockServo.h"
+#include "Stability.h"
+#include "osc_sim.h"
+
+#define CHECK(c) if (!(c)) { std::printf("FAIL line %d: %s\n", __LINE__, #c); return 1; }
+
+namespace
+{
+// stride m: not overlapped, as Stability
+double batch_avar(const std::vector<double> &x, int m)
+    {
+    double s = 0;
+    long n = 0;
+    for (size_t i = 0; i + 2 * m < x.size(); i += m)
+        {
+        double d = x[i + 2 * m] - 2 * x[i + m] + x[i];
+        s += d * d;
+        ++n;
+        }
+    return s / (2.0 * m * m * n);
+    }
+
+double batch_mvar(const std::vector<double> &x, int m)
+    {
+    auto avg = [&](size_t i)
+        {
+            double a = 0;
+            for (int j = 0; j < m; ++j)
+                {
+                a += x[i + j];
+                }
+            return a / m;
+        };
+
+    double s = 0;
+    long n = 0;
+    for (size_t i = 0; i + 3 * m <= x.size(); i += m)
+        {
+        double d = avg(i + 2 * m) - 2 * avg(i + m) + avg(i);
+        s += d * d;
+        ++n;
+        }
+    return s / (2.0 * m * m * n);
+    }
+
+// locked phase RMS after 1 day, 4 days, tuned every hour or not
+double loop_rms(double rw, bool tune, double &tau)
+    {
+    OscSim osc(ARR0 + 150, 0, rw, 4.5, 3);
+    ClockServo servo(ARR0);
+    Stability stab(90e6);
+    int u = ARR0;
+    double free = 0;
+    double s2 = 0;
+    long n = 0;
+
+    for (int k = 0; k < 4 * 86400; ++k)
+        {
+        int z = osc.step(u);
+        stab.add(z + free);
+        u = servo.update(z);
+        free += u - ARR0;
+
+        int l = stab.best_level();
+        if (tune && k % 3600 == 3599 && l >= 1)
+            {
+            double t = Stability::tau(l);
+            double r = stab.avar(0) / 3;
+            double qf = 3 * (stab.avar(l) - 3 * r / (t * t)) / t;
+            if (qf > 0)
+                {
+                servo.tune(r, qf);
+                }
+            }
+
+        if (k > 86400)
+            {
+            s2 += osc.x * osc.x;
+            ++n;
+            }
+        }
+
+    tau = servo.loop_tau();
+    return std::sqrt(s2 / n);
+    }
+}
+
+int main()
+    {
+    std::mt19937 gen(7);
+    std::normal_distribution<double> norm(0, 1);
+    const int N {1 << 17};
+    std::vector<double> x(N);
+    Stability stab(90e6);
+    double f = 150;
+    double ph = 0;
+
+    for (int i = 0; i < N; ++i)
+        {
+        f += 0.05 * norm(gen);
+        ph += f;
+        x[i] = ph + 4.5 * norm(gen);
+        stab.add(x[i]);
+        }
+
+    double worst = 0;
+    for (int k = 0; k < Stability::LEVELS && stab.count(k) >= Stability::MIN_N; ++k)
+        {
+        int m = Stability::tau(k);
+        double a = batch_avar(x, m);
+        worst = std::max(worst, std::fabs(stab.avar(k) / a - 1));
+        if (m <= 1024)
+            {
+            worst = std::max(worst, std::fabs(stab.mvar(k) / batch_mvar(x, m) - 1));
+            }
+        }
+    std::printf("streaming against batch, %d s: max relative difference %.1e\n", N,
+            worst);
+    CHECK(worst < 1e-9);
+
+    // white phase 4.5^2 = 20.25 from tau 1 s
+    CHECK(std::fabs(stab.avar(0) / 3 / 20.25 - 1) < 0.05);
+
+    // no difference over the gap: constant phase before and after
+    Stability g(90e6);
+    for (int i = 0; i < 1000; ++i)
+        {
+        g.add(0);
+        }
+    g.gap();
+    for (int i = 0; i < 1000; ++i)
+        {
+        g.add(1e6);
+        }
+    CHECK(g.avar(0) == 0 && g.count(0) > 1900);
+
+    for (double rw : {0.005, 0.05, 0.2})
+        {
+        double tau0, tau1;
+        double fixed = loop_rms(rw, false, tau0);
+        double tuned = loop_rms(rw, true, tau1);
+        std::printf("rw %5.3f: default tau %4.1f s rms %.2f, tuned tau %4.1f s rms %.2f "
+                "[ticks]\n", rw, tau0, fixed, tau1, tuned);
+        // tuned is better, most far from the default noises
+        CHECK(tuned < fixed);
+        }
+
+    return 0;
+    }
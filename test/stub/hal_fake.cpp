@@ -0,0 +1,114 @@
+/*!
+ * \file hal_fake.cpp
+ * \brief Fake UART and tick behind the stub HAL.
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include <algorithm>
+#include "hal_fake.h"
+
+DWT_Type stubDwt;
+CoreDebug_Type stubCoreDebug;
+uint32_t SystemCoreClock {180000000};
+
+namespace fake
+{
+std::string sent;
+bool txBusy {false};
+bool txFail {false};
+uint8_t *rxBuf {nullptr};
+uint16_t rxSize {0};
+uint32_t tick {0};
+uint32_t baud {0};
+void (*txDone)() {nullptr};
+}
+
+namespace
+{
+// CPU cycles since start, end of the DMA transfer
+uint64_t now {0};
+uint64_t txEnd {0};
+
+uint64_t line_cycles(int bytes)
+    {
+    return (uint64_t) bytes * 10 * SystemCoreClock / fake::baud;
+    }
+
+void set_now(uint64_t t)
+    {
+    now = t;
+    stubDwt.CYCCNT = (uint32_t) t;
+    fake::tick = t / (SystemCoreClock / 1000);
+    }
+
+// time to t, the transfer which ends before (and the next one it starts) ends
+void run_to(uint64_t t)
+    {
+    while (fake::txBusy && txEnd <= t)
+        {
+        set_now(std::max(now, txEnd));
+        fake::txBusy = false;
+        if (fake::txDone != nullptr)
+            {
+            fake::txDone();
+            }
+        }
+    set_now(std::max(now, t));
+    }
+}
+
+void fake::wait(uint32_t us)
+    {
+    run_to(now + (uint64_t) us * (SystemCoreClock / 1000000));
+    }
+
+HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef*, uint8_t *pData,
+        uint16_t size)
+    {
+    fake::rxBuf = pData;
+    fake::rxSize = size;
+    return HAL_OK;
+    }
+
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef*, const uint8_t *pData,
+        uint16_t size, uint32_t)
+    {
+    fake::sent.append((const char*) pData, size);
+    if (fake::baud != 0)
+        {
+        run_to(now + line_cycles(size));
+        }
+    return HAL_OK;
+    }
+
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef*, const uint8_t *pData,
+        uint16_t size)
+    {
+    if (fake::txBusy)
+        {
+        return HAL_BUSY;
+        }
+    if (fake::txFail)
+        {
+        fake::txFail = false;
+        return HAL_ERROR;
+        }
+
+    fake::sent.append((const char*) pData, size);
+    fake::txBusy = true;
+    if (fake::baud != 0)
+        {
+        txEnd = now + line_cycles(size);
+        }
+    return HAL_OK;
+    }
+
+uint32_t HAL_GetTick(void)
+    {
+    if (fake::baud != 0)
+        {
+        fake::wait(1);
+        }
+    return fake::tick;
+    }
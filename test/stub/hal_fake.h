@@ -0,0 +1,40 @@
+/*!
+ * \file hal_fake.h
+ * \brief Fake UART and tick behind the stub HAL: the test reads what was sent, puts
+ * received bytes where the RX DMA writes and moves the time.
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef STUB_HAL_FAKE_H_
+#define STUB_HAL_FAKE_H_
+
+#include <cstdint>
+#include <string>
+#include "stm32f4xx_hal.h"
+
+namespace fake
+{
+// bytes given to HAL_UART_Transmit / _DMA
+extern std::string sent;
+// a DMA transfer is running, the test ends it with NDisplay::processTx
+extern bool txBusy;
+// next HAL_UART_Transmit_DMA fails (and clears this)
+extern bool txFail;
+// buffer of the last HAL_UARTEx_ReceiveToIdle_DMA
+extern uint8_t *rxBuf;
+extern uint16_t rxSize;
+// HAL_GetTick
+extern uint32_t tick;
+
+// 0: time moves only when the test sets tick. Else the UART takes 10 bits per byte at
+// this rate on DWT->CYCCNT and tick: HAL_UART_Transmit waits, a DMA transfer ends in
+// wait() or while the code polls HAL_GetTick (1 us per call), then txDone is called
+extern uint32_t baud;
+extern void (*txDone)();
+
+// the caller works us, transfers which end meanwhile end
+void wait(uint32_t us);
+}
+
+#endif /* STUB_HAL_FAKE_H_ */
@@ -0,0 +1,74 @@
+/*!
+ * \file stm32f4xx_hal.h
+ * \brief Host stand-in for the HAL: only what Nxt/ needs to compile. The test defines
+ * the functions (fake UART, tick) and the register blocks.
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef STUB_STM32F4XX_HAL_H_
+#define STUB_STM32F4XX_HAL_H_
+
+#include <cstdint>
+
+typedef enum
+    {
+    HAL_OK = 0, HAL_ERROR, HAL_BUSY, HAL_TIMEOUT
+    } HAL_StatusTypeDef;
+
+typedef struct
+    {
+    int dummy;
+    } DMA_HandleTypeDef;
+
+typedef struct
+    {
+    void *Instance;
+    DMA_HandleTypeDef *hdmatx;
+    } UART_HandleTypeDef;
+
+struct DWT_Type
+    {
+    volatile uint32_t CYCCNT;
+    volatile uint32_t CTRL;
+    };
+struct CoreDebug_Type
+    {
+    volatile uint32_t DEMCR;
+    };
+extern DWT_Type stubDwt;
+extern CoreDebug_Type stubCoreDebug;
+extern uint32_t SystemCoreClock;
+#define DWT (&stubDwt)
+#define CoreDebug (&stubCoreDebug)
+#define CoreDebug_DEMCR_TRCENA_Msk 1
+#define DWT_CTRL_CYCCNTENA_Msk 1
+
+// one thread, no interrupts
+#define __disable_irq() ((void)0)
+#define __enable_irq() ((void)0)
+#define __get_PRIMASK() 0u
+#define __set_PRIMASK(x) ((void)(x))
+#define __get_IPSR() 0u
+#define __DMB() ((void)0)
+
+#define DMA_IT_HT 0
+#define __HAL_DMA_DISABLE_IT(h, it) ((void)(h))
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef *huart, uint8_t *pData,
+        uint16_t size);
+HAL_StatusTypeDef HAL_UART_Transmit(UART_HandleTypeDef *huart, const uint8_t *pData,
+        uint16_t size, uint32_t timeout);
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef *huart, const uint8_t *pData,
+        uint16_t size);
+uint32_t HAL_GetTick(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STUB_STM32F4XX_HAL_H_ */